@@ -0,0 +1,264 @@
+#ifndef ATTACKS_H
+#define ATTACKS_H
+
+#include "bitboard.h"
+#include "types.h"
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * The lookup data for the sliding attacks from one square, used by Attacks.
+ */
+struct Magic
+{
+  Bitboard mask{0};
+  Bitboard magic{0};
+  Bitboard* attacks{nullptr};
+  unsigned shift{0};
+
+  unsigned index(Bitboard occupied) const
+  {
+#if defined(__BMI2__)
+    return static_cast<unsigned>(_pext_u64(occupied, mask));
+#else
+    return static_cast<unsigned>(((occupied & mask) * magic) >> shift);
+#endif
+  }
+};
+
+constexpr std::array<std::pair<int, int>, 4> c_rook_directions{{{1, 0}, {-1, 0}, {0, 1}, {0, -1}}};
+constexpr std::array<std::pair<int, int>, 4> c_bishop_directions{{{1, 1}, {1, -1}, {-1, 1}, {-1, -1}}};
+
+/**
+ * @return The squares reached by taking one of the steps from the square,
+ * ignoring any steps that leave the board
+ */
+template <size_t N>
+constexpr Bitboard step_attacks(int square, std::array<std::pair<int, int>, N> const& steps)
+{
+  Bitboard result{0};
+  for (auto const& [dx, dy] : steps)
+  {
+    int const x = file_of(square) + dx;
+    int const y = rank_of(square) + dy;
+    if (x >= 0 && x < 8 && y >= 0 && y < 8)
+    {
+      result |= square_bb(square_index(x, y));
+    }
+  }
+  return result;
+}
+
+/**
+ * Computes sliding attacks the slow way, by walking out from the square in
+ * each direction until the edge of the board or a blocker.
+ */
+template <size_t N>
+constexpr Bitboard sliding_attacks(int square, Bitboard occupied, std::array<std::pair<int, int>, N> const& directions)
+{
+  Bitboard result{0};
+  for (auto const& [dx, dy] : directions)
+  {
+    int x = file_of(square) + dx;
+    int y = rank_of(square) + dy;
+    while (x >= 0 && x < 8 && y >= 0 && y < 8)
+    {
+      int const target = square_index(x, y);
+      result |= square_bb(target);
+      if (occupied & square_bb(target))
+      {
+        break;
+      }
+      x += dx;
+      y += dy;
+    }
+  }
+  return result;
+}
+
+/**
+ * The attacks of the pieces that jump rather than slide, which depend only
+ * on the square.
+ */
+struct LeaperAttacks
+{
+  std::array<Bitboard, c_num_squares> knight{};
+  std::array<Bitboard, c_num_squares> king{};
+  std::array<std::array<Bitboard, c_num_squares>, c_num_colors> pawn{};
+};
+
+constexpr LeaperAttacks make_leaper_attacks()
+{
+  constexpr std::array<std::pair<int, int>, 8> c_knight_steps{
+      {{1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}}};
+  constexpr std::array<std::pair<int, int>, 8> c_king_steps{
+      {{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}}};
+  constexpr std::array<std::pair<int, int>, 2> c_white_pawn_steps{{{-1, 1}, {1, 1}}};
+  constexpr std::array<std::pair<int, int>, 2> c_black_pawn_steps{{{-1, -1}, {1, -1}}};
+
+  LeaperAttacks attacks;
+  for (int square = 0; square < c_num_squares; square++)
+  {
+    attacks.knight[square] = step_attacks(square, c_knight_steps);
+    attacks.king[square] = step_attacks(square, c_king_steps);
+    attacks.pawn[index_of(Color::white)][square] = step_attacks(square, c_white_pawn_steps);
+    attacks.pawn[index_of(Color::black)][square] = step_attacks(square, c_black_pawn_steps);
+  }
+  return attacks;
+}
+
+/**
+ * For every pair of squares in a row, column or diagonal: the squares
+ * strictly between them, and the whole line through them.
+ */
+struct LineTables
+{
+  std::array<std::array<Bitboard, c_num_squares>, c_num_squares> between{};
+  std::array<std::array<Bitboard, c_num_squares>, c_num_squares> line{};
+};
+
+constexpr LineTables make_line_tables()
+{
+  LineTables tables;
+  for (int from = 0; from < c_num_squares; from++)
+  {
+    for (auto const& directions : {c_rook_directions, c_bishop_directions})
+    {
+      for (auto const& [dx, dy] : directions)
+      {
+        Bitboard const line = sliding_attacks(from, 0, std::array<std::pair<int, int>, 2>{{{dx, dy}, {-dx, -dy}}}) |
+                              square_bb(from);
+
+        // Walk away from the square, remembering what has been passed
+        Bitboard passed{0};
+        for (int x = file_of(from) + dx, y = rank_of(from) + dy; x >= 0 && x < 8 && y >= 0 && y < 8;
+             x += dx, y += dy)
+        {
+          int const to = square_index(x, y);
+          tables.between[from][to] = passed;
+          tables.line[from][to] = line;
+          passed |= square_bb(to);
+        }
+      }
+    }
+  }
+  return tables;
+}
+
+inline constexpr LeaperAttacks c_leaper_attacks{make_leaper_attacks()};
+inline constexpr LineTables c_line_tables{make_line_tables()};
+
+/**
+ * Precomputed attack tables.
+ *
+ * Knight, king and pawn attacks depend only on the square, so they are
+ * built at compile time along with the tables of squares between and along
+ * lines. Sliding piece attacks are looked up with magic bitboards: the
+ * relevant blockers for a square are multiplied by a magic number and
+ * shifted down to an index into a table of attack sets. When the compiler
+ * targets BMI2 the index is computed with a single PEXT instead, and the
+ * magic multiply is used everywhere else. The magic numbers are fixed, so
+ * startup only has to fill in the slider tables.
+ */
+class Attacks
+{
+public:
+  /**
+   * @param square The square the rook is on
+   * @param occupied The squares occupied by any piece
+   * @return The squares a rook on the square attacks
+   */
+  static Bitboard rook(int square, Bitboard occupied)
+  {
+    return _rook_magics[square].attacks[_rook_magics[square].index(occupied)];
+  }
+
+  /**
+   * @param square The square the bishop is on
+   * @param occupied The squares occupied by any piece
+   * @return The squares a bishop on the square attacks
+   */
+  static Bitboard bishop(int square, Bitboard occupied)
+  {
+    return _bishop_magics[square].attacks[_bishop_magics[square].index(occupied)];
+  }
+
+  /**
+   * @param square The square the queen is on
+   * @param occupied The squares occupied by any piece
+   * @return The squares a queen on the square attacks
+   */
+  static Bitboard queen(int square, Bitboard occupied)
+  {
+    return rook(square, occupied) | bishop(square, occupied);
+  }
+
+  /**
+   * @param square The square the knight is on
+   * @return The squares a knight on the square attacks
+   */
+  static constexpr Bitboard knight(int square)
+  {
+    return c_leaper_attacks.knight[square];
+  }
+
+  /**
+   * @param square The square the king is on
+   * @return The squares a king on the square attacks
+   */
+  static constexpr Bitboard king(int square)
+  {
+    return c_leaper_attacks.king[square];
+  }
+
+  /**
+   * @param color The color of the pawn
+   * @param square The square the pawn is on
+   * @return The squares a pawn of that color on the square attacks
+   */
+  static constexpr Bitboard pawn(Color color, int square)
+  {
+    return c_leaper_attacks.pawn[index_of(color)][square];
+  }
+
+  /**
+   * @param from The first square
+   * @param to The second square
+   * @return The squares strictly between from and to, or an empty bitboard if
+   * the squares do not share a row, column or diagonal
+   */
+  static constexpr Bitboard between(int from, int to)
+  {
+    return c_line_tables.between[from][to];
+  }
+
+  /**
+   * @param from The first square
+   * @param to The second square
+   * @return Every square on the row, column or diagonal through both squares,
+   * or an empty bitboard if they are not in a line
+   */
+  static constexpr Bitboard line(int from, int to)
+  {
+    return c_line_tables.line[from][to];
+  }
+
+  /**
+   * Fills in the slider tables. This runs automatically during static
+   * initialization and only needs to be called once.
+   */
+  static void init();
+
+private:
+  static void init_magics_(std::array<Magic, c_num_squares>& magics, Bitboard* table,
+                           std::array<Bitboard, c_num_squares> const& magic_numbers,
+                           std::array<std::pair<int, int>, 4> const& directions);
+
+  static std::array<Magic, c_num_squares> _rook_magics;
+  static std::array<Magic, c_num_squares> _bishop_magics;
+  static std::array<Bitboard, 0x19000> _rook_table;
+  static std::array<Bitboard, 0x1480> _bishop_table;
+};
+#endif
@@ -0,0 +1,97 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+/**
+ * A bitboard is a 64 bit set with one bit per square of the board.
+ * Squares are numbered from 0 (A1) to 63 (H8), walking along each row
+ * before moving up to the next one, so bit (8 * y + x) is the square at
+ * column x and row y.
+ */
+using Bitboard = uint64_t;
+
+constexpr int c_num_squares{64};
+
+/**
+ * Used in place of a square index when there is no square (for example,
+ * when no en passant capture is possible).
+ */
+constexpr int c_no_square{64};
+
+constexpr Bitboard c_empty_bb{0};
+constexpr Bitboard c_file_a_bb{0x0101010101010101ULL};
+constexpr Bitboard c_file_h_bb{c_file_a_bb << 7};
+constexpr Bitboard c_rank_1_bb{0xFFULL};
+constexpr Bitboard c_rank_8_bb{c_rank_1_bb << 56};
+
+/**
+ * @param x The column of the square (0 is column A)
+ * @param y The row of the square (0 is row 1)
+ * @return The index of the square
+ */
+constexpr int square_index(int x, int y)
+{
+  return 8 * y + x;
+}
+
+/**
+ * @param square A square index
+ * @return The column of the square (0 is column A)
+ */
+constexpr int file_of(int square)
+{
+  return square & 7;
+}
+
+/**
+ * @param square A square index
+ * @return The row of the square (0 is row 1)
+ */
+constexpr int rank_of(int square)
+{
+  return square >> 3;
+}
+
+/**
+ * @param square A square index
+ * @return A bitboard with only that square set
+ */
+constexpr Bitboard square_bb(int square)
+{
+  return Bitboard{1} << square;
+}
+
+/**
+ * @return The number of squares set in the bitboard
+ */
+constexpr int pop_count(Bitboard bb)
+{
+  return std::popcount(bb);
+}
+
+/**
+ * @return The lowest square set in the bitboard. The bitboard must not be empty.
+ */
+constexpr int lsb(Bitboard bb)
+{
+  return std::countr_zero(bb);
+}
+
+/**
+ * Removes the lowest square from the bitboard and returns it.
+ * The bitboard must not be empty.
+ */
+constexpr int pop_lsb(Bitboard& bb)
+{
+  int const square = lsb(bb);
+  bb &= bb - 1;
+  return square;
+}
+
+/**
+ * @return True if more than one square is set in the bitboard
+ */
+constexpr bool more_than_one(Bitboard bb)
+{
+  return (bb & (bb - 1)) != 0;
+}
+#endif
@@ -1,32 +1,51 @@
 #ifndef BOARD_H
 #define BOARD_H
 
+#include <position.h>
 #include <square.h>
 
-class Square;
-class Game;
-
 /**
- * A board class holds Squares, which hold pieces.
+ * The board a game is played on. The pieces live in a bitboard Position as
+ * one byte per square; the board adds the move rules a player at the
+ * console is held to.
  */
 class Board
 {
 public:
   /**
-   * Returns the square at the xy location
-   * @param x The column of the desired square (A letter)
-   * @param y The row coordinate of the desired square
-   * @return The square at the desired location
+   * Creates a board with the pieces in their starting places
+   */
+  Board();
+
+  /**
+   * @param square A square on the board
+   * @return The piece on the square, or Piece::none if it is empty
+   */
+  Piece piece_on(Square const& square) const;
+
+  /**
+   * Checks if the piece on a square may move to another square, ignoring
+   * whether the move leaves its king in check.
+   * @param from The square the piece moves from
+   * @param to The square the piece moves to
+   * @return True if a piece stands on from and the move follows its rules
+   */
+  bool can_move(Square const& from, Square const& to) const;
+
+  /**
+   * Plays a move on the board's position if it does not leave the mover's
+   * king in check.
+   * @param from The square the piece moves from
+   * @param to The square the piece moves to
+   * @param promotion What a pawn reaching the last row becomes
+   * @return True if the move was legal and has been played
    */
-  Square& square_at(int x, int y);
+  bool apply_move(Square const& from, Square const& to, PieceType promotion = PieceType::queen);
 
   /**
-   * Returns the square at the xy location
-   * @param x The column of the desired square (A letter)
-   * @param y The row coordinate of the desired square
-   * @return The square at the desired location
+   * @return The bitboard representation of the pieces on the board
    */
-  Square const& square_at(int x, int y) const;
+  Position const& position() const;
 
   /**
    * Checks if every square in between squares from and to are empty,
@@ -72,27 +91,26 @@ public:
   void display(std::ostream& out_stream) const;
 
   /**
-   * Initializes the 2D vector of squares properly.
-   * This should be called before using the board.
+   * Puts the pieces back in their starting places.
    */
   void setup();
 
+private:
   /**
-   * The effective constructor for the board
-   * @return a pointer to the single instance of the board
+   * Checks the pawn rules: one square forward onto an empty square, two
+   * from the starting row if both are empty, or one square diagonally
+   * forward onto an opposing piece.
    */
-  static Board& get_board();
-
+  bool can_pawn_move_(Square const& from, Square const& to, Color color) const;
 
   /**
-   * Destructor
+   * Checks if every square in between two squares in a line is empty.
+   * @param from The initial square
+   * @param to The final square
+   * @return True if there are no pieces between the squares
    */
-  ~Board();
-
-private:
-  Board();
+  bool is_clear_between_(Square const& from, Square const& to) const;
 
-  std::vector<Square> _squares{};
-  static inline std::unique_ptr<Board> _theBoard{nullptr};
+  Position _position{};
 };
 #endif
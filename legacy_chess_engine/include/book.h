@@ -0,0 +1,141 @@
+#ifndef BOOK_H
+#define BOOK_H
+
+#include "mapped_file.h"
+#include "move.h"
+
+class Position;
+
+/**
+ * One move of an opening book.
+ */
+struct BookEntry
+{
+  // The Zobrist hash of the position the move is played in
+  uint64_t key{0};
+  Move move{c_null_move};
+
+  // How often the move should be chosen, relative to the other moves for
+  // the same position
+  uint16_t weight{0};
+  uint32_t learn{0};
+};
+
+/**
+ * The size of a book entry on disk.
+ */
+constexpr size_t c_book_entry_size{16};
+
+/**
+ * An opening book file, memory mapped and searched in place, so books far
+ * larger than memory can be probed without loading them.
+ *
+ * The file is a sorted array of 16 byte records laid out like Polyglot's:
+ * the key, move, weight and learn fields as big endian 64, 16, 16 and 32
+ * bit numbers. The key is this engine's Zobrist hash and the move is its
+ * 16 bit Move, so Polyglot books can't be read, and the other way round.
+ *
+ * The keys are hashes, spread evenly over all 64 bit values, so a lookup
+ * starts at the key's share of the file and gallops out from there. That
+ * usually finds the key within a page or two, where a plain binary search
+ * would touch a page on every step.
+ */
+class OpeningBook
+{
+public:
+  /**
+   * Opens a book file
+   * @param path The book to open
+   * @return The book, or empty if the file can't be mapped or isn't a whole
+   * number of entries
+   */
+  static std::optional<OpeningBook> open(std::filesystem::path const& path);
+
+  /**
+   * Writes a book file
+   * @param path The file to write
+   * @param entries The book entries, sorted by key
+   * @return False if the file could not be written
+   */
+  static bool write(std::filesystem::path const& path, std::span<BookEntry const> entries);
+
+  /**
+   * Finds the book moves for a position, without allocating.
+   * @param key The Zobrist hash of the position
+   * @param entries Where to store the entries found
+   * @return The number of entries stored, at most entries.size()
+   */
+  size_t probe(uint64_t key, std::span<BookEntry> entries) const;
+
+  /**
+   * Chooses a book move at random, each in proportion to its weight.
+   * @param position The position to find a move for
+   * @param random A random number to choose with
+   * @return A legal book move, or c_null_move if the book has none
+   */
+  Move pick(Position const& position, uint64_t random) const;
+
+  /**
+   * @return The number of entries in the book
+   */
+  size_t size() const
+  {
+    return _file.size() / c_book_entry_size;
+  }
+
+private:
+  explicit OpeningBook(MappedFile file) : _file(std::move(file))
+  {
+  }
+
+  /**
+   * @return The index of the first entry whose key is not less than the key
+   */
+  size_t lower_bound_(uint64_t key) const;
+
+  uint64_t key_(size_t index) const;
+  BookEntry entry_(size_t index) const;
+
+  MappedFile _file;
+};
+
+/**
+ * Collects book moves and writes them out as a sorted book. Repeated moves
+ * are merged as they are added, so memory grows with the number of
+ * different moves rather than the number added.
+ */
+class BookWriter
+{
+public:
+  /**
+   * Adds a move to the book, or adds to its weight if it's already there
+   * @param key The Zobrist hash of the position the move is played in
+   * @param move The move
+   * @param weight How much to add to the move's weight
+   */
+  void add(uint64_t key, Move move, uint16_t weight = 1);
+
+  /**
+   * Writes the book
+   * @param path The file to write
+   * @return False if the file could not be written
+   */
+  bool write(std::filesystem::path const& path);
+
+  /**
+   * @return The number of different moves in the book
+   */
+  size_t size();
+
+private:
+  /**
+   * Sorts the entries and merges the repeated ones.
+   */
+  void merge_();
+
+  std::vector<BookEntry> _entries{};
+
+  // The entries before this index are already sorted and merged
+  size_t _merged{0};
+};
+#endif
@@ -0,0 +1,25 @@
+#ifndef EVALUATE_H
+#define EVALUATE_H
+
+#include "types.h"
+
+class PawnCache;
+class Position;
+
+/**
+ * The value of each piece type in centipawns: the traditional 1, 3, 3, 5
+ * and 9 pawns. The king is never traded, so it counts for nothing.
+ */
+constexpr std::array<int, c_num_piece_types> c_piece_values{100, 300, 300, 500, 900, 0};
+
+/**
+ * Scores a position statically: material, piece placement and pawn
+ * structure, blended from middlegame to endgame values as the pieces come
+ * off. Material and placement come precomputed from the position and the
+ * pawn structure nearly always from the cache, so this is cheap.
+ * @param position The position to score
+ * @param pawns The calling thread's pawn structure cache
+ * @return The score in centipawns from the point of view of the side to move
+ */
+int evaluate(Position const& position, PawnCache& pawns);
+#endif
@@ -1,38 +1,51 @@
 #ifndef GAME_H
 #define GAME_H
 
-class Player;
+#include "board.h"
+#include "player.h"
 
 /**
- * A game is the overarching container for the random elements of a game.
+ * A game is the overarching container for the random elements of a game. It
+ * owns the board and the players, so several games can exist side by side.
  */
 class Game
 {
 
 public:
   /**
-   * @returns the next player whose turn it is
+   * Creates a game with the pieces in their starting places.
    */
-  static Player& get_next_player();
+  Game();
+
+  Game(Game const&) = delete;
+  Game& operator=(Game const&) = delete;
 
   /**
-   * Sets up the board by putting the pieces in place.
+   * @returns the next player whose turn it is
    */
-  static void initialize();
+  Player& get_next_player();
 
   /**
    * Returns the opposite of the opposing player
    * @param player The player whose opponent to return
    * @return The opponent of the given player
    */
-  static Player& opponent_of(Player const& player);
+  Player& opponent_of(Player const& player);
+
+  /**
+   * @return The board the game is played on
+   */
+  Board& board();
 
-  ~Game();
+  /**
+   * @return The board the game is played on
+   */
+  Board const& board() const;
 
 private:
-  Game();
-  static inline Player* _player1{nullptr};
-  static inline Player* _player2{nullptr};
-  static inline Player* _currentPlayer{nullptr};
+  Board _board{};
+  Player _player1{"White", Color::white};
+  Player _player2{"Black", Color::black};
+  Player* _currentPlayer{nullptr};
 };
 #endif
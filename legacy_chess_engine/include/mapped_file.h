@@ -0,0 +1,73 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+/**
+ * A read-only file mapped into memory. The operating system pages the file
+ * in as it is read, so even very large files can be scanned, or searched at
+ * random, without reading them into buffers first.
+ */
+class MappedFile
+{
+public:
+  /**
+   * Maps a whole file
+   * @param path The file to map
+   * @return The mapping, or empty if the file could not be opened or mapped
+   */
+  static std::optional<MappedFile> open(std::filesystem::path const& path);
+
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+  ~MappedFile();
+
+  MappedFile(MappedFile const&) = delete;
+  MappedFile& operator=(MappedFile const&) = delete;
+
+  /**
+   * @return The contents of the file
+   */
+  std::span<std::byte const> bytes() const
+  {
+    return {_data, _size};
+  }
+
+  /**
+   * @return The contents of the file as text
+   */
+  std::string_view text() const
+  {
+    return {reinterpret_cast<char const*>(_data), _size};
+  }
+
+  /**
+   * @return The size of the file in bytes
+   */
+  size_t size() const
+  {
+    return _size;
+  }
+
+  /**
+   * Hints that the file will be read from start to end, so the operating
+   * system reads ahead.
+   */
+  void advise_sequential() const;
+
+  /**
+   * Hints that a range of the file won't be read again, so its pages can be
+   * dropped from memory. Reading the range afterwards is still allowed, and
+   * only costs reading it from the file again.
+   * @param offset The start of the range
+   * @param length The length of the range
+   */
+  void release(size_t offset, size_t length) const;
+
+private:
+  MappedFile(std::byte const* data, size_t size) : _data(data), _size(size)
+  {
+  }
+
+  std::byte const* _data{nullptr};
+  size_t _size{0};
+};
+#endif
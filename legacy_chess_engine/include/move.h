@@ -0,0 +1,245 @@
+#ifndef MOVE_H
+#define MOVE_H
+
+#include "bitboard.h"
+#include "types.h"
+
+/**
+ * The kinds of move that need special handling when they are applied.
+ */
+enum class MoveType : uint8_t
+{
+  normal = 0,
+  promotion,
+  en_passant,
+  castling
+};
+
+/**
+ * A move from one square to another. Castling is stored as the king's move,
+ * and promotions also record the piece the pawn becomes.
+ *
+ * A move packs into 16 bits: the from square in bits 0-5, the to square in
+ * bits 6-11, the promotion piece (knight to queen) in bits 12-13 and the
+ * move type in bits 14-15.
+ */
+class Move
+{
+public:
+  /**
+   * Creates an uninitialized move. This stays trivial so that move lists
+   * don't pay to initialize every slot.
+   */
+  Move() = default;
+
+  /**
+   * Creates a new move
+   * @param from The square the piece moves from
+   * @param to The square the piece moves to
+   * @param type The kind of move
+   * @param promotion The piece a promoting pawn becomes: knight, bishop,
+   * rook or queen
+   */
+  constexpr Move(int from, int to, MoveType type = MoveType::normal, PieceType promotion = PieceType::knight)
+      : _data(static_cast<uint16_t>(from | (to << 6) | ((index_of(promotion) - index_of(PieceType::knight)) << 12) |
+                                    (static_cast<int>(type) << 14)))
+  {
+  }
+
+  /**
+   * @param data The bits of a move, as returned by raw()
+   * @return The move
+   */
+  static constexpr Move from_raw(uint16_t data)
+  {
+    Move move;
+    move._data = data;
+    return move;
+  }
+
+  /**
+   * @return The square the piece moves from
+   */
+  constexpr int from() const
+  {
+    return _data & 0x3F;
+  }
+
+  /**
+   * @return The square the piece moves to
+   */
+  constexpr int to() const
+  {
+    return (_data >> 6) & 0x3F;
+  }
+
+  /**
+   * @return The kind of move
+   */
+  constexpr MoveType type() const
+  {
+    return static_cast<MoveType>(_data >> 14);
+  }
+
+  /**
+   * @return The piece a promoting pawn becomes. Only meaningful for promotions.
+   */
+  constexpr PieceType promotion() const
+  {
+    return static_cast<PieceType>(((_data >> 12) & 3) + index_of(PieceType::knight));
+  }
+
+  /**
+   * @return The bits of the move, for storing it compactly
+   */
+  constexpr uint16_t raw() const
+  {
+    return _data;
+  }
+
+  constexpr bool operator==(Move const& other) const = default;
+
+private:
+  uint16_t _data;
+};
+
+static_assert(sizeof(Move) == 2);
+
+/**
+ * A placeholder for "no move". A piece can never move to its own square, so
+ * this is never a real move.
+ */
+constexpr Move c_null_move{0, 0};
+
+/**
+ * @param move A move
+ * @return The move in coordinate notation, such as "e2e4" or "e7e8q"
+ */
+std::string to_string(Move move);
+
+/**
+ * @param square A square index
+ * @return The name of the square, such as "e4"
+ */
+std::string square_name(int square);
+
+/**
+ * No legal chess position has more than 218 moves.
+ */
+constexpr int c_max_moves{256};
+
+/**
+ * A fixed capacity list of moves that lives entirely on the stack, with a
+ * score beside each move for ordering. The scores are left uninitialized
+ * until someone sets them.
+ */
+class MoveList
+{
+public:
+  /**
+   * Adds a move to the end of the list
+   * @param move The move to add
+   */
+  void push_back(Move move)
+  {
+    _moves[_size++] = move;
+  }
+
+  /**
+   * @param index The position of a move in the list
+   * @return The ordering score of the move
+   */
+  int& score(int index)
+  {
+    return _scores[index];
+  }
+
+  /**
+   * @param index The position of a move in the list
+   * @return The ordering score of the move
+   */
+  int score(int index) const
+  {
+    return _scores[index];
+  }
+
+  /**
+   * Exchanges two moves along with their scores
+   * @param first The position of one move
+   * @param second The position of the other
+   */
+  void swap(int first, int second)
+  {
+    std::swap(_moves[first], _moves[second]);
+    std::swap(_scores[first], _scores[second]);
+  }
+
+  /**
+   * Removes every move from the list
+   */
+  void clear()
+  {
+    _size = 0;
+  }
+
+  /**
+   * @return The number of moves in the list
+   */
+  int size() const
+  {
+    return _size;
+  }
+
+  /**
+   * @return True if the list holds no moves
+   */
+  bool empty() const
+  {
+    return _size == 0;
+  }
+
+  /**
+   * @param move The move to look for
+   * @return True if the list holds the move
+   */
+  bool contains(Move move) const
+  {
+    return std::find(begin(), end(), move) != end();
+  }
+
+  Move& operator[](int index)
+  {
+    return _moves[index];
+  }
+
+  Move const& operator[](int index) const
+  {
+    return _moves[index];
+  }
+
+  Move* begin()
+  {
+    return _moves.data();
+  }
+
+  Move* end()
+  {
+    return _moves.data() + _size;
+  }
+
+  Move const* begin() const
+  {
+    return _moves.data();
+  }
+
+  Move const* end() const
+  {
+    return _moves.data() + _size;
+  }
+
+private:
+  std::array<Move, c_max_moves> _moves;
+  std::array<int, c_max_moves> _scores;
+  int _size{0};
+};
+#endif
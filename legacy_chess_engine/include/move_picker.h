@@ -0,0 +1,167 @@
+#ifndef MOVE_PICKER_H
+#define MOVE_PICKER_H
+
+#include "move.h"
+#include "position.h"
+
+/**
+ * The largest size a history score can reach, for or against a move.
+ */
+constexpr int c_max_history{16384};
+
+/**
+ * @param position The position the move is played in
+ * @param move A legal move
+ * @return True if the move neither captures nor promotes
+ */
+inline bool is_quiet(Position const& position, Move move)
+{
+  return !position.is_occupied(move.to()) && move.type() != MoveType::promotion &&
+         move.type() != MoveType::en_passant;
+}
+
+/**
+ * Remembers how often each quiet move has caused a beta cutoff, indexed by
+ * the side moving and the move's from and to squares (a butterfly table).
+ * A move that causes a cutoff gains and the quiet moves tried before it
+ * lose. Each update moves the score part of the way to its limit, so a move
+ * that stops working falls back quickly.
+ */
+class HistoryTable
+{
+public:
+  /**
+   * @param color The side making the move
+   * @param move A quiet move
+   * @return The move's score, between -c_max_history and c_max_history
+   */
+  int score(Color color, Move move) const
+  {
+    return _scores[index_of(color)][move.from()][move.to()];
+  }
+
+  /**
+   * Moves a score toward a bonus
+   * @param color The side making the move
+   * @param move A quiet move
+   * @param bonus Positive if the move caused a cutoff, negative if it didn't
+   */
+  void update(Color color, Move move, int bonus)
+  {
+    int& score = _scores[index_of(color)][move.from()][move.to()];
+    bonus = std::clamp(bonus, -c_max_history, c_max_history);
+    score += bonus - score * std::abs(bonus) / c_max_history;
+  }
+
+  /**
+   * Halves every score, so what was learned in earlier searches counts for
+   * less than what the next one finds.
+   */
+  void age();
+
+private:
+  std::array<std::array<std::array<int, c_num_squares>, c_num_squares>, c_num_colors> _scores{};
+};
+
+/**
+ * The two most recent quiet moves to cause a beta cutoff at a ply. A move
+ * that refutes one line often refutes its siblings too.
+ */
+using Killers = std::array<Move, 2>;
+
+/**
+ * Hands out the legal moves of a position one at a time, most promising
+ * first, so that a beta cutoff usually comes from one of the first few:
+ *
+ * 1. The transposition table move
+ * 2. Captures and promotions that don't lose material by static exchange
+ *    evaluation, most valuable victim first and then least valuable
+ *    attacker (MVV-LVA)
+ * 3. The killer moves
+ * 4. The other quiet moves, by history score
+ * 5. The captures that lose material
+ *
+ * Quiet moves aren't generated until the captures have been tried, so a
+ * node cut off by a capture never generates them. Each stage is sorted
+ * lazily, by picking the best remaining move as it is asked for.
+ *
+ * For the quiescence search the picker returns only stage 2.
+ */
+class MovePicker
+{
+public:
+  /**
+   * @param position The position to pick moves in. It must not change while
+   * the picker is in use.
+   * @param tt_move The move the transposition table suggests, or
+   * c_null_move. It is only returned if it is legal.
+   * @param killers The killer moves for the ply
+   * @param history The history scores of quiet moves
+   */
+  MovePicker(Position const& position, Move tt_move, Killers const& killers, HistoryTable const& history);
+
+  /**
+   * Creates a picker for the quiescence search, which returns only the
+   * captures and promotions that don't lose material.
+   * @param position The position to pick moves in. It must not change while
+   * the picker is in use.
+   * @param history The history scores of quiet moves, which go unused
+   */
+  MovePicker(Position const& position, HistoryTable const& history);
+
+  /**
+   * @return The next move, or c_null_move once every legal move has been
+   * returned
+   */
+  Move next();
+
+private:
+  enum class Stage : uint8_t
+  {
+    tt_move,
+    captures,
+    killers,
+    quiets,
+    bad_captures,
+    done
+  };
+
+  void generate_captures_();
+  void generate_quiets_();
+
+  /**
+   * @param moves The stage's moves
+   * @param next The number of moves already picked from the list
+   * @param skip_killers True to skip the killer moves as well as the
+   * transposition table move, which earlier stages returned
+   * @return The best scored move left in the list, or c_null_move if none
+   * are left
+   */
+  Move pick_best_(MoveList& moves, int& next, bool skip_killers);
+
+  /**
+   * @return The best capture left that doesn't lose material. The others
+   * are set aside for the last stage.
+   */
+  Move pick_good_capture_();
+
+  Position const& _position;
+  HistoryTable const& _history;
+  Move _tt_move;
+  Killers _killers;
+  Stage _stage{Stage::tt_move};
+  bool _captures_only{false};
+
+  MoveList _captures;
+  bool _captures_generated{false};
+  int _next_capture{0};
+
+  MoveList _bad_captures;
+  int _next_bad_capture{0};
+
+  MoveList _quiets;
+  bool _quiets_generated{false};
+  int _next_quiet{0};
+  int _next_killer{0};
+};
+#endif
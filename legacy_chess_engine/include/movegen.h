@@ -0,0 +1,39 @@
+#ifndef MOVEGEN_H
+#define MOVEGEN_H
+
+#include "move.h"
+
+class Position;
+
+/**
+ * Fills the list with every legal move for the side to move, including
+ * captures, promotions, castling and en passant. Nothing is allocated.
+ * @param position The position to generate moves for
+ * @param moves The list to fill. It is cleared first.
+ */
+void generate_legal_moves(Position const& position, MoveList& moves);
+
+/**
+ * Fills the list with the legal captures, en passant captures and
+ * promotions: the moves that change the material on the board.
+ * @param position The position to generate moves for
+ * @param moves The list to fill. It is cleared first.
+ */
+void generate_legal_captures(Position const& position, MoveList& moves);
+
+/**
+ * Fills the list with the legal moves generate_legal_captures leaves out,
+ * castling included. Between them the two generate every legal move.
+ * @param position The position to generate moves for
+ * @param moves The list to fill. It is cleared first.
+ */
+void generate_legal_quiets(Position const& position, MoveList& moves);
+
+/**
+ * Finds the legal move written in coordinate notation.
+ * @param position The position the move is played in
+ * @param text The move, such as "e2e4" or "e7e8q"
+ * @return The move, or c_null_move if no legal move matches
+ */
+Move parse_move(Position const& position, std::string_view text);
+#endif
@@ -0,0 +1,75 @@
+#ifndef PAWNS_H
+#define PAWNS_H
+
+#include "position.h"
+#include "psqt.h"
+
+/**
+ * The number of entries in each PawnCache, a power of two.
+ */
+constexpr size_t c_pawn_cache_entries{size_t{1} << 13};
+
+/**
+ * What the pawns are worth as a structure, which depends on nothing but
+ * where the pawns stand.
+ */
+struct PawnEntry
+{
+  // Position::pawn_hash() of the structure
+  uint64_t key{0};
+
+  // White's advantage from passed, isolated, doubled and backward pawns
+  Score score{};
+
+  // The middlegame bonus for the pawns in front of each side's king, by the
+  // file the king is on, for a king still on its first two ranks
+  std::array<std::array<int16_t, 8>, c_num_colors> shelter{};
+
+  /**
+   * @param position A position with this entry's pawns
+   * @param color A side
+   * @return The middlegame bonus for the pawns sheltering the side's king
+   */
+  int king_shelter(Position const& position, Color color) const
+  {
+    int const king = position.king_square(color);
+    int const rank = (color == Color::white) ? rank_of(king) : 7 - rank_of(king);
+    return (rank <= 1) ? shelter[index_of(color)][file_of(king)] : 0;
+  }
+};
+
+/**
+ * @return The entry for the pawns of a position, worked out from scratch
+ */
+PawnEntry evaluate_pawns(Position const& position);
+
+/**
+ * A small cache of pawn structure scores, keyed by the pawn hash. The pawns
+ * rarely change between one node and the next, so nearly every lookup
+ * finds its entry. Each search thread has its own, so it needs no locking.
+ */
+class PawnCache
+{
+public:
+  PawnCache();
+
+  /**
+   * Finds the entry for the position's pawns, evaluating them if they aren't
+   * cached or were overwritten
+   * @param position Any position
+   * @return The entry, valid until the next call
+   */
+  PawnEntry const& probe(Position const& position)
+  {
+    PawnEntry& entry = _entries[position.pawn_hash() & (c_pawn_cache_entries - 1)];
+    if (entry.key != position.pawn_hash())
+    {
+      entry = evaluate_pawns(position);
+    }
+    return entry;
+  }
+
+private:
+  std::vector<PawnEntry> _entries;
+};
+#endif
@@ -0,0 +1,14 @@
+#ifndef PERFT_H
+#define PERFT_H
+
+class Position;
+
+/**
+ * Counts the leaf nodes of the tree of legal moves, which is the standard way
+ * to check a move generator against known results.
+ * @param position The position to count from. It is restored before returning.
+ * @param depth The number of half moves to look ahead
+ * @return The number of positions reachable in exactly depth half moves
+ */
+uint64_t perft(Position& position, int depth);
+#endif
@@ -0,0 +1,38 @@
+#ifndef PGN_H
+#define PGN_H
+
+#include "position.h"
+
+/**
+ * Finds where the next game in Portable Game Notation text starts: the
+ * first tag line that follows some movetext.
+ * @param text The PGN text
+ * @param from The start of a line to search from
+ * @return The offset of the next game, or the size of the text if there is none
+ */
+size_t next_pgn_game(std::string_view text, size_t from);
+
+/**
+ * What was found by playing through one PGN game.
+ */
+struct PgnGame
+{
+  // The position after the last move played
+  Position position{Position::start_position()};
+  std::string_view result{"*"};
+  int plies{0};
+
+  // Why the game could not be played to the end, or empty if it was
+  std::string error{};
+};
+
+/**
+ * Plays through the moves of one game, starting from its FEN tag if it has
+ * one. Comments, variations, annotations and move numbers are skipped.
+ * @param game The tags and movetext of one game, as split by next_pgn_game
+ * @param on_move If set, called with the position and the move before each
+ * move is played. Returning false stops reading the game there.
+ * @return The final position and what stopped the game
+ */
+PgnGame read_pgn_game(std::string_view game, std::function<bool(Position const&, Move)> const& on_move = {});
+#endif
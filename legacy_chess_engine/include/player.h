@@ -1,13 +1,14 @@
 #ifndef PLAYER_H
 #define PLAYER_H
 
-class King;
-class Piece;
-class Square;
+#include "piece.h"
+#include "square.h"
+
+class Board;
 
 /**
  * A player class represents one of the players in a chess game. It
- * can keep track of its pieces and make a move.
+ * plays one color, keeps the pieces it has captured and can make a move.
  */
 class Player
 {
@@ -16,10 +17,9 @@ public:
   /**
    * Constructs a new player
    * @param name The player's name
-   * @param my_king The player's king
-   * @param my_pieces The player's pieces
+   * @param color The color of the player's pieces
    */
-  Player(std::string name, King& my_king);
+  Player(std::string name, Color color);
 
   /**
    * The destructor for the player class
@@ -28,9 +28,10 @@ public:
 
   /**
    * Makes a move
-   * @return True if the move is legal
+   * @param board The board to move on
+   * @return False if the player resigns
    */
-  bool make_move();
+  bool make_move(Board& board);
 
   /**
    * @return The name of the player
@@ -46,51 +47,44 @@ public:
    * Adds a piece to the player's captured collection
    * @param a_piece The piece to capture
    */
-  void capture(Piece& a_piece);
+  void capture(Piece a_piece);
 
   /**
-   * Removes a piece from the player's captured collection.
-   * @param a_piece the piece to remove
+   * @return The color of the player's pieces
    */
-  void uncapture(Piece& a_piece);
-
-  /**
-   * @return The player's pieces
-   */
-  std::set<Piece*>& my_pieces();
-
-  /**
-   * @return The player's pieces
-   */
-  std::set<Piece*> const& my_pieces() const;
+  Color color() const;
 
+private:
   /**
-   * @return The player's king
+   * A move as typed at the console.
    */
-  King& my_king() const;
+  struct RequestedMove
+  {
+    Square from;
+    Square to;
+    PieceType promotion; // What a pawn reaching the last row becomes
+  };
 
-private:
   /**
    * Prompts the user for a move and returns the beginning and ending squares
    * @param in The input stream to read the prompt from
    * @param out The output stream to print prompts to.
-   * @return A std::pair of squares representing the beginning and ending of the
-   * std::string. Note: The std::pair and both squares must be deleted. Returns nullptr
-   * if the player resigns.
+   * @return The squares and promotion piece of the move, or empty if the
+   * player resigns.
    */
-  std::optional<std::pair<Square, Square>> prompt_move_(std::istream& in, std::ostream& out);
+  std::optional<RequestedMove> prompt_move_(std::istream& in, std::ostream& out);
 
   /**
    * Checks if the input std::string is contains the correct form of the
    * move input.
    * @param std::string The std::string of which to check the validity
-   * @return true if the std::string is of the form "A2 D2"
+   * @return true if the std::string is of the form "A2 D2", optionally
+   * followed by the piece to promote to as in "A7 A8 N"
    */
   bool is_valid_(const std::string& line);
 
   std::string _name;
-  std::set<Piece*> _pieces{};
-  std::set<Piece*> _captured{};
-  King* _king{nullptr};
+  Color _color;
+  std::vector<Piece> _captured{};
 };
 #endif
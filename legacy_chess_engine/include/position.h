@@ -0,0 +1,427 @@
+#ifndef POSITION_H
+#define POSITION_H
+
+#include "bitboard.h"
+#include "move.h"
+#include "piece.h"
+#include "psqt.h"
+#include "types.h"
+
+constexpr uint8_t c_castle_white_kingside{1};
+constexpr uint8_t c_castle_white_queenside{2};
+constexpr uint8_t c_castle_black_kingside{4};
+constexpr uint8_t c_castle_black_queenside{8};
+constexpr uint8_t c_castle_all{15};
+
+/**
+ * The longest FEN record to_fen can write: 71 characters of placement, the
+ * side, four castling letters, an en passant square, both clocks at their
+ * largest and the spaces between them.
+ */
+constexpr int c_max_fen_length{92};
+
+/**
+ * The state make_move overwrites that can't be worked out from the move
+ * itself, plus the hash and checkers so they don't need to be worked out in
+ * reverse. Callers keep one per ply, typically in a preallocated array, and
+ * hand the same record back to unmake_move.
+ */
+struct Undo
+{
+  PieceType captured;
+  bool is_capture;
+  uint8_t castling_rights;
+  uint8_t en_passant_square;
+  uint8_t halfmove_clock;
+  uint64_t hash;
+  Bitboard checkers;
+};
+
+/**
+ * A Position is a complete description of a chess game at one point in time,
+ * stored as a set of bitboards: one per piece type, one per color, plus the
+ * piece on each square (so looking up a square is a single byte load), the
+ * side to move, castling rights, en passant square, move clocks and a Zobrist
+ * hash that identifies the position, plus a second hash of the pawns alone.
+ * Like the hashes, the material and
+ * piece-square score and the game phase are updated as pieces come and go,
+ * so evaluating a position doesn't have to look at every square.
+ *
+ * Positions are small plain values with no pointers into other objects, so
+ * they can be copied with a memcpy. Each search thread, search stack or
+ * batch job keeps its own copies rather than sharing one board.
+ */
+class Position
+{
+public:
+  /**
+   * Creates an empty position with white to move and no castling rights.
+   */
+  Position();
+
+  /**
+   * @return A position with all 32 pieces in their starting squares
+   */
+  static Position start_position();
+
+  /**
+   * Reads a position in Forsyth-Edwards Notation. Only the piece placement
+   * is required; missing fields take their defaults. The record is read in
+   * place, without allocating.
+   * @param fen The FEN record, for example
+   * "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
+   * Castling rights without their king and rook in place, and an en
+   * passant square no pawn can have just crossed, are dropped.
+   * @return The position, or empty if the record is malformed, a pawn is on
+   * the first or last rank, or the side not to move is in check
+   */
+  static std::optional<Position> from_fen(std::string_view fen);
+
+  /**
+   * Writes the position in Forsyth-Edwards Notation without allocating.
+   * @param out A buffer of at least c_max_fen_length characters. No null
+   * terminator is written.
+   * @return One past the last character written
+   */
+  char* write_fen(char* out) const;
+
+  /**
+   * @return The position in Forsyth-Edwards Notation
+   */
+  std::string to_fen() const;
+
+  /**
+   * @return The squares occupied by any piece
+   */
+  Bitboard occupied() const
+  {
+    return _by_color[0] | _by_color[1];
+  }
+
+  /**
+   * @param color The side whose pieces to return
+   * @return The squares occupied by the side
+   */
+  Bitboard pieces(Color color) const
+  {
+    return _by_color[index_of(color)];
+  }
+
+  /**
+   * @param type The kind of piece to return
+   * @return The squares occupied by pieces of that type, of either color
+   */
+  Bitboard pieces(PieceType type) const
+  {
+    return _by_type[index_of(type)];
+  }
+
+  /**
+   * @param type The kind of piece to return
+   * @param color The side whose pieces to return
+   * @return The squares occupied by pieces of that type and color
+   */
+  Bitboard pieces(PieceType type, Color color) const
+  {
+    return _by_type[index_of(type)] & _by_color[index_of(color)];
+  }
+
+  /**
+   * @param square A square index
+   * @return True if a piece is on the square
+   */
+  bool is_occupied(int square) const
+  {
+    return (occupied() & square_bb(square)) != 0;
+  }
+
+  /**
+   * @param square A square index
+   * @return The piece on the square, or Piece::none if it is empty
+   */
+  Piece piece_on(int square) const
+  {
+    return _mailbox[square];
+  }
+
+  /**
+   * @param square An occupied square index
+   * @return The type of the piece on the square
+   */
+  PieceType type_on(int square) const
+  {
+    return type_of(_mailbox[square]);
+  }
+
+  /**
+   * @param square An occupied square index
+   * @return The color of the piece on the square
+   */
+  Color color_on(int square) const
+  {
+    return color_of(_mailbox[square]);
+  }
+
+  /**
+   * @param color The side whose king to find
+   * @return The square of that side's king
+   */
+  int king_square(Color color) const
+  {
+    return lsb(pieces(PieceType::king, color));
+  }
+
+  /**
+   * @param square A square index
+   * @param occupied The squares to treat as occupied when looking for blockers
+   * @return The squares of every piece, of either color, that attacks the square
+   */
+  Bitboard attackers_to(int square, Bitboard occupied) const;
+
+  /**
+   * @param square A square index
+   * @param by The side doing the attacking
+   * @return True if any piece of that side attacks the square
+   */
+  bool is_attacked(int square, Color by) const
+  {
+    return (attackers_to(square, occupied()) & pieces(by)) != 0;
+  }
+
+  /**
+   * @return The enemy pieces giving check to the side to move. This is
+   * worked out once per move by make_move, so it costs nothing to ask.
+   */
+  Bitboard checkers() const
+  {
+    return _checkers;
+  }
+
+  /**
+   * @return True if the side to move's king is attacked
+   */
+  bool in_check() const
+  {
+    return _checkers != 0;
+  }
+
+  /**
+   * Finds the pieces that are pinned to their king: each is the only piece
+   * between the king and an enemy rook, bishop or queen lined up on it, so
+   * it may only move along that line.
+   * @param color The side whose pinned pieces to find
+   * @return The pinned pieces of that side
+   */
+  Bitboard pinned(Color color) const;
+
+  /**
+   * Places a piece on an empty square.
+   * @param type The kind of piece
+   * @param color The color of the piece
+   * @param square The square to place it on
+   */
+  void put_piece(PieceType type, Color color, int square);
+
+  /**
+   * Removes the piece from an occupied square.
+   * @param square The square to clear
+   */
+  void remove_piece(int square);
+
+  /**
+   * Moves a piece from an occupied square to an empty one.
+   * @param from The square the piece is on
+   * @param to The empty square to move to
+   */
+  void move_piece(int from, int to);
+
+  /**
+   * Plays a legal move for the side to move.
+   * @param move The move to play
+   * @param undo Filled with what unmake_move needs to take the move back
+   */
+  void make_move(Move move, Undo& undo);
+
+  /**
+   * Takes back the last move played.
+   * @param move The move passed to make_move
+   * @param undo The record make_move filled in
+   */
+  void unmake_move(Move move, Undo const& undo);
+
+  /**
+   * Passes the turn to the other side without moving, as the search does to
+   * test whether a position is so good that even a free move for the
+   * opponent doesn't help it. The side to move must not be in check.
+   * @param undo Filled with what unmake_null_move needs
+   */
+  void make_null_move(Undo& undo);
+
+  /**
+   * Takes back make_null_move.
+   * @param undo The record make_null_move filled in
+   */
+  void unmake_null_move(Undo const& undo);
+
+  /**
+   * @return The Zobrist hash of the position, kept up to date as pieces move
+   */
+  uint64_t hash() const
+  {
+    return _hash;
+  }
+
+  /**
+   * Computes the Zobrist hash from scratch. This should always match hash().
+   * @return The Zobrist hash of the position
+   */
+  uint64_t compute_hash() const;
+
+  /**
+   * @return The Zobrist hash of the pawns alone, kept up to date as pawns
+   * move, promote and are captured. Positions with the same pawns share it,
+   * whatever else is on the board.
+   */
+  uint64_t pawn_hash() const
+  {
+    return _pawn_hash;
+  }
+
+  /**
+   * Computes the pawn hash from scratch. This should always match
+   * pawn_hash().
+   * @return The Zobrist hash of the pawns
+   */
+  uint64_t compute_pawn_hash() const;
+
+  /**
+   * @return The material and piece-square score of the pieces, white's
+   * advantage in the middlegame and in the endgame, kept up to date as
+   * pieces move
+   */
+  Score piece_square_score() const
+  {
+    return _piece_square;
+  }
+
+  /**
+   * Computes the piece-square score from scratch. This should always match
+   * piece_square_score().
+   * @return White's material and piece-square advantage
+   */
+  Score compute_piece_square_score() const;
+
+  /**
+   * @return How much material is left, from 0 with only kings and pawns to
+   * c_max_phase with all the pieces (more after a promotion)
+   */
+  int phase() const
+  {
+    return _phase;
+  }
+
+  /**
+   * @return The side whose turn it is
+   */
+  Color side_to_move() const
+  {
+    return _side_to_move;
+  }
+
+  /**
+   * @param color The side whose turn it is
+   */
+  void set_side_to_move(Color color);
+
+  /**
+   * @return A combination of the c_castle_* flags
+   */
+  uint8_t castling_rights() const
+  {
+    return _castling_rights;
+  }
+
+  /**
+   * @param rights A combination of the c_castle_* flags
+   */
+  void set_castling_rights(uint8_t rights);
+
+  /**
+   * @return The square a pawn can capture onto en passant, or c_no_square
+   */
+  int en_passant_square() const
+  {
+    return _en_passant_square;
+  }
+
+  /**
+   * @param square The square a pawn can capture onto en passant, or c_no_square
+   */
+  void set_en_passant_square(int square);
+
+  /**
+   * @return The number of half moves since the last capture or pawn move
+   */
+  int halfmove_clock() const
+  {
+    return _halfmove_clock;
+  }
+
+  /**
+   * @param halfmoves The number of half moves since the last capture or pawn
+   * move. The clock stops at 255, which is well past a fifty move draw.
+   */
+  void set_halfmove_clock(int halfmoves);
+
+  /**
+   * @return The number of the full move, starting at 1 and incremented after black moves
+   */
+  int fullmove_number() const
+  {
+    return _fullmove_number;
+  }
+
+  /**
+   * @param number The number of the full move
+   */
+  void set_fullmove_number(int number);
+
+  /**
+   * Works out the checkers of the side to move from scratch. Call this after
+   * setting up a position piece by piece; make_move and from_fen keep the
+   * checkers up to date themselves.
+   */
+  void update_checkers();
+
+  /**
+   * Prints the position to the specified std::ostream
+   * @param out The stream to print to
+   */
+  void display(std::ostream& out) const;
+
+private:
+  /**
+   * Turns the piece on a square into another type of the same color, as
+   * when a pawn promotes or the promotion is taken back.
+   * @param square An occupied square index
+   * @param type The piece's new type
+   */
+  void change_type_(int square, PieceType type);
+
+  std::array<Bitboard, c_num_piece_types> _by_type{};
+  std::array<Piece, c_num_squares> _mailbox{};
+  std::array<Bitboard, c_num_colors> _by_color{};
+  Color _side_to_move{Color::white};
+  uint8_t _castling_rights{0};
+  uint8_t _en_passant_square{c_no_square};
+  uint8_t _halfmove_clock{0};
+  uint16_t _fullmove_number{1};
+  uint64_t _hash{0};
+  uint64_t _pawn_hash{0};
+  Bitboard _checkers{0};
+  Score _piece_square{};
+  int _phase{0};
+};
+
+static_assert(std::is_trivially_copyable_v<Position>, "Positions are copied with memcpy");
+#endif
@@ -0,0 +1,170 @@
+#ifndef PSQT_H
+#define PSQT_H
+
+#include "bitboard.h"
+#include "evaluate.h"
+#include "types.h"
+
+/**
+ * A pair of scores in centipawns, one for the middlegame and one for the
+ * endgame. The evaluation blends the two by how much material is left.
+ */
+struct Score
+{
+  int mg{0};
+  int eg{0};
+
+  constexpr Score& operator+=(Score other)
+  {
+    mg += other.mg;
+    eg += other.eg;
+    return *this;
+  }
+
+  constexpr Score& operator-=(Score other)
+  {
+    mg -= other.mg;
+    eg -= other.eg;
+    return *this;
+  }
+
+  constexpr Score operator-() const
+  {
+    return {-mg, -eg};
+  }
+
+  constexpr bool operator==(Score const&) const = default;
+};
+
+/**
+ * How much each piece type counts toward the game phase. The starting
+ * position adds up to c_max_phase; a bare board with kings and pawns is 0.
+ */
+constexpr std::array<int, c_num_piece_types> c_phase_weights{0, 1, 1, 2, 4, 0};
+constexpr int c_max_phase{24};
+
+namespace psqt
+{
+using Table = std::array<int, c_num_squares>;
+
+// The tables are laid out as a diagram from white's side, rank 8 first, so
+// they read like the board. Black uses them mirrored.
+constexpr Table c_pawn_mg{
+   0,   0,   0,   0,   0,   0,   0,   0,
+  50,  50,  50,  50,  50,  50,  50,  50,
+  10,  10,  20,  30,  30,  20,  10,  10,
+   5,   5,  10,  25,  25,  10,   5,   5,
+   0,   0,   0,  20,  20,   0,   0,   0,
+   5,  -5, -10,   0,   0, -10,  -5,   5,
+   5,  10,  10, -20, -20,  10,  10,   5,
+   0,   0,   0,   0,   0,   0,   0,   0};
+
+// In the endgame a pawn is worth more the closer it is to promoting
+constexpr Table c_pawn_eg{
+   0,   0,   0,   0,   0,   0,   0,   0,
+  80,  80,  80,  80,  80,  80,  80,  80,
+  50,  50,  50,  50,  50,  50,  50,  50,
+  30,  30,  30,  30,  30,  30,  30,  30,
+  15,  15,  15,  15,  15,  15,  15,  15,
+   5,   5,   5,   5,   5,   5,   5,   5,
+   0,   0,   0,   0,   0,   0,   0,   0,
+   0,   0,   0,   0,   0,   0,   0,   0};
+
+constexpr Table c_knight{
+ -50, -40, -30, -30, -30, -30, -40, -50,
+ -40, -20,   0,   0,   0,   0, -20, -40,
+ -30,   0,  10,  15,  15,  10,   0, -30,
+ -30,   5,  15,  20,  20,  15,   5, -30,
+ -30,   0,  15,  20,  20,  15,   0, -30,
+ -30,   5,  10,  15,  15,  10,   5, -30,
+ -40, -20,   0,   5,   5,   0, -20, -40,
+ -50, -40, -30, -30, -30, -30, -40, -50};
+
+constexpr Table c_bishop{
+ -20, -10, -10, -10, -10, -10, -10, -20,
+ -10,   0,   0,   0,   0,   0,   0, -10,
+ -10,   0,   5,  10,  10,   5,   0, -10,
+ -10,   5,   5,  10,  10,   5,   5, -10,
+ -10,   0,  10,  10,  10,  10,   0, -10,
+ -10,  10,  10,  10,  10,  10,  10, -10,
+ -10,   5,   0,   0,   0,   0,   5, -10,
+ -20, -10, -10, -10, -10, -10, -10, -20};
+
+constexpr Table c_rook{
+   0,   0,   0,   0,   0,   0,   0,   0,
+   5,  10,  10,  10,  10,  10,  10,   5,
+  -5,   0,   0,   0,   0,   0,   0,  -5,
+  -5,   0,   0,   0,   0,   0,   0,  -5,
+  -5,   0,   0,   0,   0,   0,   0,  -5,
+  -5,   0,   0,   0,   0,   0,   0,  -5,
+  -5,   0,   0,   0,   0,   0,   0,  -5,
+   0,   0,   0,   5,   5,   0,   0,   0};
+
+constexpr Table c_queen{
+ -20, -10, -10,  -5,  -5, -10, -10, -20,
+ -10,   0,   0,   0,   0,   0,   0, -10,
+ -10,   0,   5,   5,   5,   5,   0, -10,
+  -5,   0,   5,   5,   5,   5,   0,  -5,
+   0,   0,   5,   5,   5,   5,   0,  -5,
+ -10,   5,   5,   5,   5,   5,   0, -10,
+ -10,   0,   5,   0,   0,   0,   0, -10,
+ -20, -10, -10,  -5,  -5, -10, -10, -20};
+
+// The king hides behind its pawns while there are pieces to attack it...
+constexpr Table c_king_mg{
+ -30, -40, -40, -50, -50, -40, -40, -30,
+ -30, -40, -40, -50, -50, -40, -40, -30,
+ -30, -40, -40, -50, -50, -40, -40, -30,
+ -30, -40, -40, -50, -50, -40, -40, -30,
+ -20, -30, -30, -40, -40, -30, -30, -20,
+ -10, -20, -20, -20, -20, -20, -20, -10,
+  20,  20,   0,   0,   0,   0,  20,  20,
+  20,  30,  10,   0,   0,  10,  30,  20};
+
+// ...and heads for the center once they are gone
+constexpr Table c_king_eg{
+ -50, -40, -30, -20, -20, -30, -40, -50,
+ -30, -20, -10,   0,   0, -10, -20, -30,
+ -30, -10,  20,  30,  30,  20, -10, -30,
+ -30, -10,  30,  40,  40,  30, -10, -30,
+ -30, -10,  30,  40,  40,  30, -10, -30,
+ -30, -10,  20,  30,  30,  20, -10, -30,
+ -30, -30,   0,   0,   0,   0, -30, -30,
+ -50, -30, -30, -30, -30, -30, -30, -50};
+
+constexpr std::array<Table const*, c_num_piece_types> c_mg_tables{&c_pawn_mg, &c_knight, &c_bishop,
+                                                                  &c_rook,    &c_queen,  &c_king_mg};
+constexpr std::array<Table const*, c_num_piece_types> c_eg_tables{&c_pawn_eg, &c_knight, &c_bishop,
+                                                                  &c_rook,    &c_queen,  &c_king_eg};
+} // namespace psqt
+
+/**
+ * The material and placement score of each piece on each square, from
+ * white's point of view: black's entries are mirrored and negated, so the
+ * sum over the board is white's advantage. The material part comes from
+ * c_piece_values.
+ */
+using PieceSquareTable = std::array<std::array<std::array<Score, c_num_squares>, c_num_piece_types>, c_num_colors>;
+
+constexpr PieceSquareTable make_piece_square_table()
+{
+  PieceSquareTable table{};
+  for (int type = 0; type < c_num_piece_types; type++)
+  {
+    for (int square = 0; square < c_num_squares; square++)
+    {
+      // The diagram index of the square for white, and of its mirror for black
+      int const white_index = square_index(file_of(square), 7 - rank_of(square));
+      int const black_index = square;
+      int const value = c_piece_values[type];
+      Score const white{value + (*psqt::c_mg_tables[type])[white_index], value + (*psqt::c_eg_tables[type])[white_index]};
+      Score const black{value + (*psqt::c_mg_tables[type])[black_index], value + (*psqt::c_eg_tables[type])[black_index]};
+      table[index_of(Color::white)][type][square] = white;
+      table[index_of(Color::black)][type][square] = -black;
+    }
+  }
+  return table;
+}
+
+inline constexpr PieceSquareTable c_piece_square{make_piece_square_table()};
+#endif
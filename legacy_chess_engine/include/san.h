@@ -0,0 +1,19 @@
+#ifndef SAN_H
+#define SAN_H
+
+#include "move.h"
+
+class Position;
+
+/**
+ * Finds the legal move written in Standard Algebraic Notation, as used in
+ * PGN files. Check and annotation suffixes such as "+", "#", "!" and "?"
+ * are ignored, castling may be written with letter O or digit zero, and a
+ * promotion may leave out the "=".
+ * @param position The position the move is played in
+ * @param san The move, such as "e4", "Nbd7", "exd6", "O-O" or "e8=Q+"
+ * @return The move, or c_null_move if no legal move matches or the notation
+ * is ambiguous
+ */
+Move parse_san(Position const& position, std::string_view san);
+#endif
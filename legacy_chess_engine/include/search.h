@@ -0,0 +1,208 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "position.h"
+
+class Tablebases;
+class TranspositionTable;
+
+/**
+ * The deepest the search can go, in half moves from the root.
+ */
+constexpr int c_max_ply{128};
+
+/**
+ * The score of being checkmated at the root. Being mated in n half moves
+ * scores -(c_mate_score - n).
+ */
+constexpr int c_mate_score{32000};
+constexpr int c_infinity{32001};
+
+/**
+ * Scores this close to c_mate_score are forced mates.
+ */
+constexpr int c_mate_bound{c_mate_score - c_max_ply};
+
+/**
+ * When to stop searching. Any limit left at zero is ignored, and the search
+ * stops at the first limit reached.
+ *
+ * movetime is a hard limit that interrupts the search. soft_movetime only
+ * stops the search between iterations: once it has passed, the next
+ * iteration would probably not finish before the hard limit anyway.
+ */
+struct SearchLimits
+{
+  int depth{0};
+  uint64_t nodes{0};
+  std::chrono::milliseconds movetime{0};
+  std::chrono::milliseconds soft_movetime{0};
+};
+
+/**
+ * The selective search techniques, which trade a little accuracy for a lot
+ * of depth. Each can be turned off, to measure what it is worth or to rule
+ * it out when chasing a bug.
+ */
+struct SearchFeatures
+{
+  // Give the opponent a free move, and prune if the position still holds
+  bool null_move{true};
+
+  // Search moves late in the ordering less deeply, unless they surprise
+  bool late_move_reductions{true};
+
+  // Near the leaves, skip quiet moves that can't reach alpha and cut off
+  // positions far above beta
+  bool futility_pruning{true};
+
+  // Near the leaves, hand positions far below alpha to the quiescence search
+  bool razoring{true};
+};
+
+/**
+ * The outcome of a search, or of one iteration of it.
+ */
+struct SearchResult
+{
+  Move best_move{c_null_move};
+  int score{0};
+  int depth{0};
+  uint64_t nodes{0};
+  std::chrono::milliseconds time{0};
+  std::vector<Move> pv{};
+};
+
+class SearchWorker;
+
+/**
+ * An iterative deepening alpha-beta search.
+ *
+ * Each iteration searches the root one half move deeper with principal
+ * variation search (a full window for the first move, null windows to prove
+ * the rest are worse), starting from an aspiration window around the
+ * previous score. Results are shared through the transposition table.
+ *
+ * With more than one thread the search is Lazy SMP: every thread searches
+ * the same root on its own copy of the position, and they help each other
+ * only through the shared transposition table. Helpers start at staggered
+ * depths so they fill the table ahead of the main thread rather than
+ * repeating its work. The result is always the main thread's, and a single
+ * thread search runs on the calling thread and is deterministic.
+ *
+ * The search is selective: null move pruning, late move reductions,
+ * futility pruning and razoring skip or shorten lines that are unlikely to
+ * matter (see SearchFeatures). At depth zero a quiescence search resolves
+ * the captures before the position is evaluated.
+ *
+ * With tablebases set, positions they cover are scored from the tables
+ * wherever the search reaches them, rather than searched.
+ */
+class Search
+{
+public:
+  /**
+   * Creates a search
+   * @param table The transposition table to read and fill
+   * @param threads The number of threads to search with
+   */
+  explicit Search(TranspositionTable& table, int threads = 1);
+  ~Search();
+
+  Search(Search const&) = delete;
+  Search& operator=(Search const&) = delete;
+
+  /**
+   * Finds the best move in a position.
+   * @param position The position to search
+   * @param limits When to stop
+   * @param history The hashes of the positions earlier in the game, oldest
+   * first, so repetitions of them are scored as draws
+   * @return The best move found and its principal variation. The best move
+   * is c_null_move if the side to move has no legal moves.
+   */
+  SearchResult run(Position const& position, SearchLimits const& limits, std::span<uint64_t const> history = {});
+
+  /**
+   * Asks a running search to stop as soon as possible. Safe to call from
+   * another thread.
+   */
+  void stop();
+
+  /**
+   * Changes the number of threads. Must not be called during a search.
+   * @param threads The number of threads to search with, at least one
+   */
+  void set_threads(int threads);
+
+  /**
+   * @return The number of threads the search uses
+   */
+  int threads() const;
+
+  /**
+   * @param callback Called with the result of each completed iteration of
+   * the main thread
+   */
+  void set_iteration_callback(std::function<void(SearchResult const&)> callback);
+
+  /**
+   * Changes the endgame tables. Must not be called during a search.
+   * @param tablebases The tables to score endgames from, or null for none.
+   * They must outlive the search.
+   */
+  void set_tablebases(Tablebases const* tablebases);
+
+  /**
+   * Turns selective search techniques on or off. Must not be called during
+   * a search.
+   * @param features The techniques to use
+   */
+  void set_features(SearchFeatures const& features);
+
+  /**
+   * @return The selective search techniques in use
+   */
+  SearchFeatures const& features() const
+  {
+    return _features;
+  }
+
+private:
+  friend class SearchWorker;
+
+  /**
+   * @return The nodes searched so far by every thread
+   */
+  uint64_t nodes_() const;
+
+  /**
+   * Sets the stop flag if a time or node limit has been reached. Only the
+   * main thread checks.
+   */
+  void check_limits_();
+
+  /**
+   * @return The time since the search started
+   */
+  std::chrono::milliseconds elapsed_() const;
+
+  TranspositionTable& _table;
+  std::function<void(SearchResult const&)> _iteration_callback{};
+  Tablebases const* _tablebases{nullptr};
+  SearchFeatures _features{};
+  std::atomic<bool> _stop{false};
+
+  SearchLimits _limits{};
+  std::chrono::steady_clock::time_point _start{};
+
+  // The main thread's worker comes first
+  std::vector<std::unique_ptr<SearchWorker>> _workers{};
+};
+
+/**
+ * @param score A search score
+ * @return The score as "cp <centipawns>" or "mate <moves>"
+ */
+std::string format_score(int score);
+#endif
@@ -0,0 +1,22 @@
+#ifndef SEE_H
+#define SEE_H
+
+#include "move.h"
+
+class Position;
+
+/**
+ * Works out what a capture wins once both sides have made every capture on
+ * its square that pays for them (static exchange evaluation). Each side
+ * recaptures with its least valuable piece first, sliders lined up behind
+ * a capturing piece join in as it leaves, and either side may stop
+ * capturing when going on would lose. Pins are ignored, and a king only
+ * captures onto a square the other side no longer attacks.
+ * @param position The position the move is played in
+ * @param move A legal capture or promotion. A quiet move scores how much it
+ * loses if the piece is taken on its new square.
+ * @return The material the side to move gains, in centipawns, or a
+ * negative number if it loses material
+ */
+int static_exchange(Position const& position, Move move);
+#endif
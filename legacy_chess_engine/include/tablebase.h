@@ -0,0 +1,297 @@
+#ifndef TABLEBASE_H
+#define TABLEBASE_H
+
+#include "mapped_file.h"
+#include "position.h"
+
+/**
+ * The most pieces, kings included, a table may have.
+ */
+constexpr int c_max_tablebase_pieces{5};
+
+/**
+ * The pieces of each side, such as "KQKR": white's king and pieces, then
+ * black's, each strongest first.
+ */
+class Material
+{
+public:
+  /**
+   * Reads a material name
+   * @param name Two groups of K, Q, R, B, N and P letters, each starting
+   * with a king, for example "KBNK"
+   * @return The material, or empty if the name is malformed or has more
+   * than c_max_tablebase_pieces pieces
+   */
+  static std::optional<Material> parse(std::string_view name);
+
+  /**
+   * @return The pieces on the board
+   */
+  static Material of(Position const& position);
+
+  /**
+   * @return The material's name, such as "KQKR"
+   */
+  std::string name() const;
+
+  /**
+   * @param color A side
+   * @param type A kind of piece
+   * @return How many of those pieces the side has
+   */
+  int count(Color color, PieceType type) const
+  {
+    return _counts[index_of(color)][index_of(type)];
+  }
+
+  /**
+   * @param color A side
+   * @param type A kind of piece
+   * @param change How many of the pieces to add, or to take away if negative
+   * @return The material with the side's pieces changed
+   */
+  Material changed(Color color, PieceType type, int change) const
+  {
+    Material material = *this;
+    material._counts[index_of(color)][index_of(type)] = static_cast<uint8_t>(count(color, type) + change);
+    return material;
+  }
+
+  /**
+   * @return The number of pieces of both sides, kings included
+   */
+  int total() const;
+
+  /**
+   * @return True if either side has a pawn
+   */
+  bool has_pawns() const
+  {
+    return count(Color::white, PieceType::pawn) + count(Color::black, PieceType::pawn) > 0;
+  }
+
+  /**
+   * @return True if neither side can ever mate: bare kings, or a king and a
+   * single bishop or knight against a king
+   */
+  bool is_trivial_draw() const;
+
+  /**
+   * @return The same pieces with the colors swapped
+   */
+  Material flipped() const;
+
+  /**
+   * @return The same pieces with the stronger side as white, the way tables
+   * are named and stored
+   */
+  Material normalized() const;
+
+  bool operator==(Material const&) const = default;
+
+private:
+  std::array<std::array<uint8_t, c_num_piece_types>, c_num_colors> _counts{};
+};
+
+/**
+ * Numbers every placement of a set of pieces with either side to move, so
+ * a table can be a plain array with one entry per position.
+ *
+ * The index is the side to move, then white's king, then the square of each
+ * other piece in turn. Reflecting the board doesn't change the outcome, so
+ * white's king is kept in the a1-d1-d4 triangle without pawns (10 squares)
+ * and on the a-d files with them (32 squares, since pawns only allow the
+ * left-right mirror). Pieces of the same kind are interchangeable, so their
+ * squares are kept in increasing order. Each position takes the smallest
+ * index of its reflections, and the indexes no position maps to are simply
+ * left unused.
+ */
+class TablebaseIndex
+{
+public:
+  /**
+   * @param material The pieces of the table
+   */
+  explicit TablebaseIndex(Material const& material);
+
+  /**
+   * @return The number of entries in the table
+   */
+  uint64_t size() const
+  {
+    return _size;
+  }
+
+  /**
+   * @param position A position with the table's pieces, or with the colors
+   * of the table's pieces swapped
+   * @param flip_colors True if the position's colors are swapped: it is
+   * then indexed as the mirror image with white and black exchanged
+   * @return The position's index
+   */
+  uint64_t index(Position const& position, bool flip_colors) const;
+
+  /**
+   * Rebuilds the position an index stands for, without castling rights or
+   * en passant square.
+   * @param index An index below size()
+   * @return The position, or empty if no legal position has the index:
+   * pieces overlap, a pawn is on the first or last rank, the side not to
+   * move is in check, or the index isn't the smallest of its reflections
+   */
+  std::optional<Position> position(uint64_t index) const;
+
+private:
+  /**
+   * @param squares The square of each piece, in table order
+   * @param side The side to move
+   * @return The smallest index of the reflections of the placement
+   */
+  uint64_t canonical_index_(std::array<int, c_max_tablebase_pieces> squares, Color side) const;
+
+  // The color and type of each piece in table order, white's king first
+  std::array<std::pair<Color, PieceType>, c_max_tablebase_pieces> _pieces{};
+  int _count{0};
+  bool _has_pawns{false};
+  uint64_t _size{0};
+};
+
+/**
+ * Who wins with perfect play, from the side to move's point of view.
+ */
+enum class Wdl : int8_t
+{
+  loss = -1,
+  draw = 0,
+  win = 1
+};
+
+/**
+ * What a table knows about a position.
+ */
+struct TablebaseResult
+{
+  Wdl wdl{Wdl::draw};
+
+  // The half moves until mate with best play by both sides, or 0 for a draw
+  int plies{0};
+};
+
+/**
+ * Tables store one byte per position: 0 for a draw, otherwise one more than
+ * the half moves to mate. An even number of half moves means the side to
+ * move is mated, an odd number that it mates.
+ */
+constexpr uint8_t encode_tablebase_value(int plies)
+{
+  return static_cast<uint8_t>(plies + 1);
+}
+
+constexpr TablebaseResult decode_tablebase_value(uint8_t value)
+{
+  if (value == 0)
+  {
+    return {};
+  }
+  int const plies = value - 1;
+  return {(plies % 2 == 0) ? Wdl::loss : Wdl::win, plies};
+}
+
+/**
+ * The longest mate a table can store, leaving the byte value 255 free.
+ */
+constexpr int c_max_tablebase_plies{253};
+
+/**
+ * Distance to mate tables for endgames with few pieces, memory mapped so
+ * only the pages a search touches are read.
+ *
+ * Each table is a file named after its material, such as KQKR.tb: a 24 byte
+ * header (the magic "LCTB", a version byte, the piece count, two reserved
+ * bytes, the material name padded to 8 bytes and the entry count as a
+ * little endian 64 bit number) followed by one byte per TablebaseIndex
+ * entry. A table answers for both colors, so KQKR.tb also covers KRKQ.
+ * Bare kings, and a king and one bishop or knight against a king, are
+ * drawn without a table once any table is loaded.
+ *
+ * Tables ignore castling and en passant, so positions with castling rights
+ * or an en passant square aren't probed, and a double pawn push is scored
+ * as if it couldn't be taken en passant. They also ignore the fifty move
+ * rule.
+ */
+class Tablebases
+{
+public:
+  /**
+   * Maps every table in a directory
+   * @param directory Where the .tb files are
+   * @return The number of tables added
+   */
+  int add_directory(std::filesystem::path const& directory);
+
+  /**
+   * Maps one table, replacing any table already loaded for its material
+   * @param path The .tb file
+   * @return False if the file can't be mapped or isn't a valid table
+   */
+  bool add(std::filesystem::path const& path);
+
+  /**
+   * Unmaps every table.
+   */
+  void clear();
+
+  /**
+   * Looks a position up, without allocating.
+   * @param position Any position
+   * @return The outcome, or empty if no table covers the position
+   */
+  std::optional<TablebaseResult> probe(Position const& position) const
+  {
+    if (pop_count(position.occupied()) > _max_pieces)
+    {
+      return {};
+    }
+    return probe_(position);
+  }
+
+  /**
+   * @return The number of pieces in the largest table, or 0 without tables
+   */
+  int max_pieces() const
+  {
+    return _max_pieces;
+  }
+
+  /**
+   * @return The number of tables loaded
+   */
+  size_t size() const
+  {
+    return _tables.size();
+  }
+
+  /**
+   * Writes a table file
+   * @param path The file to write
+   * @param material The pieces of the table, normalized
+   * @param values One byte per TablebaseIndex entry
+   * @return False if the file could not be written
+   */
+  static bool write(std::filesystem::path const& path, Material const& material, std::span<uint8_t const> values);
+
+private:
+  struct Table
+  {
+    Material material;
+    TablebaseIndex index;
+    MappedFile file;
+  };
+
+  std::optional<TablebaseResult> probe_(Position const& position) const;
+
+  std::vector<Table> _tables{};
+  int _max_pieces{0};
+};
+#endif
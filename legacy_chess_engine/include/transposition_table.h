@@ -0,0 +1,130 @@
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+
+#include "move.h"
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
+
+/**
+ * How a stored score relates to the true score of the position.
+ */
+enum class Bound : uint8_t
+{
+  none = 0,
+  upper, // The search failed low, so the true score is at most this
+  lower, // The search failed high, so the true score is at least this
+  exact
+};
+
+/**
+ * What the table remembers about a position.
+ */
+struct TTEntry
+{
+  Move move;
+  int16_t score;
+  int8_t depth;
+  Bound bound;
+};
+
+/**
+ * A hash table of search results keyed by Zobrist hash, shared by every
+ * search thread.
+ *
+ * The table is an array of 64 byte buckets (one cache line each) holding
+ * four slots. Each slot is two 64 bit words: the packed entry, and the entry
+ * XORed with its key. Threads read and write the words without locks; if two
+ * writes interleave the words no longer XOR back to the key, and the probe
+ * treats the slot as a miss instead of returning a mixed-up entry.
+ */
+class TranspositionTable
+{
+public:
+  /**
+   * Creates a table
+   * @param megabytes The approximate memory to use
+   */
+  explicit TranspositionTable(size_t megabytes = 16);
+
+  /**
+   * Reallocates the table, discarding its contents. Must not be called while
+   * a search is using the table.
+   * @param megabytes The approximate memory to use. The table is rounded down
+   * to a power of two buckets.
+   */
+  void resize(size_t megabytes);
+
+  /**
+   * Forgets every stored entry.
+   */
+  void clear();
+
+  /**
+   * Marks the start of a new search, so entries from earlier searches are
+   * replaced first.
+   */
+  void new_search();
+
+  /**
+   * Looks up a position.
+   * @param key The Zobrist hash of the position
+   * @return The stored entry, or empty if the position is not in the table
+   */
+  std::optional<TTEntry> probe(uint64_t key) const;
+
+  /**
+   * Stores the result of searching a position.
+   * @param key The Zobrist hash of the position
+   * @param entry What to remember about the position
+   */
+  void store(uint64_t key, TTEntry const& entry);
+
+  /**
+   * Starts loading the bucket for a key into the cache, so a probe shortly
+   * afterwards doesn't wait on memory.
+   * @param key The Zobrist hash of the position about to be probed
+   */
+  void prefetch(uint64_t key) const
+  {
+#if defined(_MSC_VER)
+    _mm_prefetch(reinterpret_cast<char const*>(&bucket_(key)), _MM_HINT_T0);
+#else
+    __builtin_prefetch(&bucket_(key));
+#endif
+  }
+
+  /**
+   * @return How full the table is with entries from the current search, in
+   * parts per thousand
+   */
+  int hashfull() const;
+
+  /**
+   * @return The size of the table in megabytes
+   */
+  size_t megabytes() const;
+
+private:
+  struct Slot
+  {
+    std::atomic<uint64_t> check{0};
+    std::atomic<uint64_t> data{0};
+  };
+
+  struct alignas(64) Bucket
+  {
+    std::array<Slot, 4> slots;
+  };
+
+  Bucket& bucket_(uint64_t key) const
+  {
+    return _buckets[key & _mask];
+  }
+
+  std::unique_ptr<Bucket[]> _buckets{};
+  uint64_t _mask{0};
+  uint8_t _generation{0};
+};
+#endif
@@ -0,0 +1,52 @@
+#ifndef TYPES_H
+#define TYPES_H
+
+enum class Color : uint8_t
+{
+  black = 0,
+  white
+};
+
+/**
+ * The kinds of piece in a chess game, independent of their color.
+ */
+enum class PieceType : uint8_t
+{
+  pawn = 0,
+  knight,
+  bishop,
+  rook,
+  queen,
+  king
+};
+
+constexpr int c_num_colors{2};
+constexpr int c_num_piece_types{6};
+
+/**
+ * @param color A color
+ * @return The other color
+ */
+constexpr Color opposite(Color color)
+{
+  return (color == Color::white) ? Color::black : Color::white;
+}
+
+/**
+ * @param color A color
+ * @return An index usable for arrays sized by c_num_colors
+ */
+constexpr int index_of(Color color)
+{
+  return static_cast<int>(color);
+}
+
+/**
+ * @param type A piece type
+ * @return An index usable for arrays sized by c_num_piece_types
+ */
+constexpr int index_of(PieceType type)
+{
+  return static_cast<int>(type);
+}
+#endif
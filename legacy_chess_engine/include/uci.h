@@ -0,0 +1,95 @@
+#ifndef UCI_H
+#define UCI_H
+
+#include "book.h"
+#include "position.h"
+#include "search.h"
+#include "tablebase.h"
+#include "transposition_table.h"
+
+/**
+ * Speaks the Universal Chess Interface, so the engine can be driven by
+ * chess GUIs and tournament managers.
+ *
+ * Commands are read on the calling thread and each search runs on a worker
+ * thread, so "stop", "isready" and "quit" are answered while the engine is
+ * thinking. Supported commands are uci, isready, ucinewgame, setoption
+ * (Hash, Threads, Book and TablebasePath), position, go, stop and quit.
+ *
+ * With a book set, go plays a book move straight away when the book has
+ * one for the position, unless the search is infinite (analysis).
+ */
+class Uci
+{
+public:
+  /**
+   * Creates the protocol handler
+   * @param in Where commands are read from
+   * @param out Where responses are written to
+   */
+  Uci(std::istream& in, std::ostream& out);
+  ~Uci();
+
+  Uci(Uci const&) = delete;
+  Uci& operator=(Uci const&) = delete;
+
+  /**
+   * Answers commands until "quit" or the end of the input. At the end of
+   * the input a search with limits is allowed to finish.
+   */
+  void run();
+
+private:
+  void handle_setoption_(std::istringstream& command);
+  void handle_position_(std::istringstream& command);
+  void handle_go_(std::istringstream& command);
+
+  /**
+   * Prints one completed iteration as an info line.
+   */
+  void send_info_(SearchResult const& result);
+
+  /**
+   * Writes a line of output. Safe to call from the search thread.
+   */
+  void send_(std::string const& line);
+
+  /**
+   * Stops the running search. Safe to call before the search thread has
+   * started searching.
+   */
+  void request_stop_();
+
+  /**
+   * Waits for the search thread to print its best move and finish.
+   * @param interrupt True to stop the search first, false to let it reach
+   * its limits. A search without limits is always stopped.
+   */
+  void finish_search_(bool interrupt);
+
+  std::istream& _in;
+  std::ostream& _out;
+  std::mutex _output_mutex{};
+
+  TranspositionTable _table{};
+  Search _search{_table};
+
+  // The position set by the last "position" command, and the hashes of the
+  // positions before it in the game
+  Position _position{Position::start_position()};
+  std::vector<uint64_t> _history{};
+
+  std::optional<OpeningBook> _book{};
+  Tablebases _tablebases{};
+  std::mt19937_64 _random{std::random_device{}()};
+
+  std::thread _searcher{};
+  bool _infinite{false};
+
+  // An infinite search may finish by itself, but the best move must not be
+  // sent until the GUI says "stop"
+  std::mutex _stop_mutex{};
+  std::condition_variable _stop_signal{};
+  bool _stop_requested{false};
+};
+#endif
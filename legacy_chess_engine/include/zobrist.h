@@ -0,0 +1,63 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include "bitboard.h"
+#include "types.h"
+
+/**
+ * The random keys XORed together to form a position's Zobrist hash: one per
+ * piece on each square, one per set of castling rights, one per en passant
+ * column and one for black to move.
+ */
+struct ZobristKeys
+{
+  std::array<std::array<std::array<uint64_t, c_num_squares>, c_num_piece_types>, c_num_colors> pieces{};
+  std::array<uint64_t, 16> castling{};
+  std::array<uint64_t, 8> en_passant_file{};
+  uint64_t black_to_move{0};
+};
+
+/**
+ * Fills the keys from a splitmix64 sequence with a fixed seed, so hashes are
+ * the same in every build and the tables cost nothing at startup.
+ */
+constexpr ZobristKeys make_zobrist_keys()
+{
+  uint64_t state = 0x2545F4914F6CDD1DULL;
+  auto next = [&state]()
+  {
+    state += 0x9E3779B97F4A7C15ULL;
+    uint64_t z = state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  };
+
+  ZobristKeys keys;
+  for (auto& color : keys.pieces)
+  {
+    for (auto& type : color)
+    {
+      for (auto& key : type)
+      {
+        key = next();
+      }
+    }
+  }
+
+  // No castling rights leaves the hash unchanged
+  for (size_t rights = 1; rights < keys.castling.size(); rights++)
+  {
+    keys.castling[rights] = next();
+  }
+
+  for (auto& key : keys.en_passant_file)
+  {
+    key = next();
+  }
+  keys.black_to_move = next();
+  return keys;
+}
+
+inline constexpr ZobristKeys c_zobrist{make_zobrist_keys()};
+#endif
@@ -0,0 +1,89 @@
+#include "attacks.h"
+
+namespace
+{
+// Magic numbers that map every blocker subset of each square's mask to a
+// slot holding the right attack set, found once by random search
+constexpr std::array<Bitboard, c_num_squares> c_rook_magic_numbers{
+    0x0A80004000801220ULL, 0x8040004010002008ULL, 0x2080200010008008ULL, 0x1100100008210004ULL,
+    0xC200209084020008ULL, 0x2100010004000208ULL, 0x0400081000822421ULL, 0x0200010422048844ULL,
+    0x0800800080400024ULL, 0x0001402000401000ULL, 0x3000801000802001ULL, 0x4400800800100083ULL,
+    0x0904802402480080ULL, 0x4040800400020080ULL, 0x0018808042000100ULL, 0x4040800080004100ULL,
+    0x0040048001458024ULL, 0x00A0004000205000ULL, 0x3100808010002000ULL, 0x4825010010000820ULL,
+    0x5004808008000401ULL, 0x2024818004000A00ULL, 0x0005808002000100ULL, 0x2100060004806104ULL,
+    0x0080400880008421ULL, 0x4062220600410280ULL, 0x010A004A00108022ULL, 0x0000100080080080ULL,
+    0x0021000500080010ULL, 0x0044000202001008ULL, 0x0000100400080102ULL, 0xC020128200040545ULL,
+    0x0080002000400040ULL, 0x0000804000802004ULL, 0x0000120022004080ULL, 0x010A386103001001ULL,
+    0x9010080080800400ULL, 0x8440020080800400ULL, 0x0004228824001001ULL, 0x000000490A000084ULL,
+    0x0080002000504000ULL, 0x200020005000C000ULL, 0x0012088020420010ULL, 0x0010010080080800ULL,
+    0x0085001008010004ULL, 0x0002000204008080ULL, 0x0040413002040008ULL, 0x0000304081020004ULL,
+    0x0080204000800080ULL, 0x3008804000290100ULL, 0x1010100080200080ULL, 0x2008100208028080ULL,
+    0x5000850800910100ULL, 0x8402019004680200ULL, 0x0120911028020400ULL, 0x0000008044010200ULL,
+    0x0020850200244012ULL, 0x0020850200244012ULL, 0x0000102001040841ULL, 0x140900040A100021ULL,
+    0x000200282410A102ULL, 0x000200282410A102ULL, 0x000200282410A102ULL, 0x4048240043802106ULL};
+
+constexpr std::array<Bitboard, c_num_squares> c_bishop_magic_numbers{
+    0x40106000A1160020ULL, 0x0020010250810120ULL, 0x2010010220280081ULL, 0x002806004050C040ULL,
+    0x0002021018000000ULL, 0x2001112010000400ULL, 0x0881010120218080ULL, 0x1030820110010500ULL,
+    0x0000120222042400ULL, 0x2000020404040044ULL, 0x8000480094208000ULL, 0x0003422A02000001ULL,
+    0x000A220210100040ULL, 0x8004820202226000ULL, 0x0018234854100800ULL, 0x0100004042101040ULL,
+    0x0004001004082820ULL, 0x0010000810010048ULL, 0x1014004208081300ULL, 0x2080818802044202ULL,
+    0x0040880C00A00100ULL, 0x0080400200522010ULL, 0x0001000188180B04ULL, 0x0080249202020204ULL,
+    0x1004400004100410ULL, 0x00013100A0022206ULL, 0x2148500001040080ULL, 0x4241080011004300ULL,
+    0x4020848004002000ULL, 0x10101380D1004100ULL, 0x0008004422020284ULL, 0x01010A1041008080ULL,
+    0x0808080400082121ULL, 0x0808080400082121ULL, 0x0091128200100C00ULL, 0x0202200802010104ULL,
+    0x8C0A020200440085ULL, 0x01A0008080B10040ULL, 0x0889520080122800ULL, 0x100902022202010AULL,
+    0x04081A0816002000ULL, 0x0000681208005000ULL, 0x8170840041008802ULL, 0x0A00004200810805ULL,
+    0x0830404408210100ULL, 0x2602208106006102ULL, 0x1048300680802628ULL, 0x2602208106006102ULL,
+    0x0602010120110040ULL, 0x0941010801043000ULL, 0x000040440A210428ULL, 0x0008240020880021ULL,
+    0x0400002012048200ULL, 0x00AC102001210220ULL, 0x0220021002009900ULL, 0x84440C080A013080ULL,
+    0x0001008044200440ULL, 0x0004C04410841000ULL, 0x2000500104011130ULL, 0x1A0C010011C20229ULL,
+    0x0044800112202200ULL, 0x0434804908100424ULL, 0x0300404822C08200ULL, 0x48081010008A2A80ULL};
+
+// Build the slider tables before main() runs so lookups never need a guard.
+struct AttackTableInitializer
+{
+  AttackTableInitializer()
+  {
+    Attacks::init();
+  }
+} const c_initializer;
+} // namespace
+
+std::array<Magic, c_num_squares> Attacks::_rook_magics{};
+std::array<Magic, c_num_squares> Attacks::_bishop_magics{};
+std::array<Bitboard, 0x19000> Attacks::_rook_table{};
+std::array<Bitboard, 0x1480> Attacks::_bishop_table{};
+
+void Attacks::init_magics_(std::array<Magic, c_num_squares>& magics, Bitboard* table,
+                           std::array<Bitboard, c_num_squares> const& magic_numbers,
+                           std::array<std::pair<int, int>, 4> const& directions)
+{
+  for (int square = 0; square < c_num_squares; square++)
+  {
+    // Blockers on the edge of the board never change the attack set, so they
+    // are left out of the mask to keep the tables small.
+    Bitboard const edges = ((c_rank_1_bb | c_rank_8_bb) & ~(c_rank_1_bb << (8 * rank_of(square)))) |
+                           ((c_file_a_bb | c_file_h_bb) & ~(c_file_a_bb << file_of(square)));
+
+    Magic& magic = magics[square];
+    magic.mask = sliding_attacks(square, 0, directions) & ~edges;
+    magic.magic = magic_numbers[square];
+    magic.shift = static_cast<unsigned>(64 - pop_count(magic.mask));
+    magic.attacks = (square == 0) ? table : magics[square - 1].attacks + (1 << (64 - magics[square - 1].shift));
+
+    // Enumerate every subset of the mask with the carry-rippler trick
+    Bitboard subset = 0;
+    do
+    {
+      magic.attacks[magic.index(subset)] = sliding_attacks(square, subset, directions);
+      subset = (subset - magic.mask) & magic.mask;
+    } while (subset);
+  }
+}
+
+void Attacks::init()
+{
+  init_magics_(_rook_magics, _rook_table.data(), c_rook_magic_numbers, c_rook_directions);
+  init_magics_(_bishop_magics, _bishop_table.data(), c_bishop_magic_numbers, c_bishop_directions);
+}
@@ -1,24 +1,13 @@
 #include "board.h"
+#include "attacks.h"
 
 constexpr int c_board_dimension{8};
 
-Board& Board::get_board()
-{
-  if (_theBoard == nullptr)
-  {
-    // Use new to access private constructor
-    _theBoard = std::unique_ptr<Board>(new Board());
-  }
-  return *_theBoard;
-}
-
 Board::Board()
 {
   setup();
 }
 
-Board::~Board() = default;
-
 /**
  * Calculates the distance between two squares on the board
  * @param from The first square
@@ -53,91 +42,127 @@ int Board::distance_between(Square const& from, Square const& to) const
 
 void Board::setup()
 {
-  _squares.clear();
-  for (char i = 0; i < c_board_dimension; i++)
-  {
-    for (int j = 0; j < c_board_dimension; j++)
-    {
-      // The squares should be stored with their zero based xy coordinates
-      // so that the array access math works out nicely.
-      _squares.emplace_back(i, j, nullptr);
-    }
-  }
+  _position = Position::start_position();
 }
 
-Square& Board::square_at(int x, int y)
+Piece Board::piece_on(Square const& square) const
 {
-  return const_cast<Square&>(std::as_const(*this).square_at(x, y));
+  return _position.piece_on(square.index());
 }
 
-Square const& Board::square_at(int x, int y) const
+bool Board::can_move(Square const& from, Square const& to) const
 {
-  return _squares.at(c_board_dimension * x + y);
+  Piece const piece = _position.piece_on(from.index());
+  if (piece == Piece::none)
+  {
+    return false;
+  }
+
+  // No piece may land on a friend, which also rules out staying put
+  Color const color = color_of(piece);
+  Bitboard const target = square_bb(to.index());
+  if (_position.pieces(color) & target)
+  {
+    return false;
+  }
+
+  // Everything but the pawn moves to the squares it attacks, which a single
+  // table lookup covers along with the squares in between
+  Bitboard const occupied = _position.occupied();
+  switch (type_of(piece))
+  {
+  case PieceType::pawn:
+    return can_pawn_move_(from, to, color);
+  case PieceType::knight:
+    return (Attacks::knight(from.index()) & target) != 0;
+  case PieceType::bishop:
+    return (Attacks::bishop(from.index(), occupied) & target) != 0;
+  case PieceType::rook:
+    return (Attacks::rook(from.index(), occupied) & target) != 0;
+  case PieceType::queen:
+    return (Attacks::queen(from.index(), occupied) & target) != 0;
+  case PieceType::king:
+    //TODO: Support Castling
+    return (Attacks::king(from.index()) & target) != 0;
+  }
+  return false;
 }
 
-bool Board::is_clear_vertical(Square const& from, Square const& to) const
+bool Board::can_pawn_move_(Square const& from, Square const& to, Color color) const
 {
-  // Set up the counter for the while loop.
-  // Assume we are going to start from one space ahead of the current square
-  // and walk straight until we hit the destination square
+  bool const is_white = (color == Color::white);
 
-  if (from.get_x() != to.get_x())
+  // Make sure the pawn is moving forward
+  int const forward = to.get_y() - from.get_y();
+  if ((is_white && forward <= 0) || (!is_white && forward >= 0))
   {
     return false;
   }
-  
-  Square const* top = &to;
-  Square const* bottom = &from;
-  // Set up the squares so we always walk up.
-  // So if "to" is above "from", swap them.
-  if (to.get_y() < from.get_y())
+
+  // A pawn can move two spaces on its first move, which is the only time it
+  // is on its starting row
+  int const start_row = is_white ? 1 : 6;
+  int const max_distance = (from.get_y() == start_row) ? 2 : 1;
+
+  int const move_distance = distance_between(from, to);
+  if (move_distance < 1 || move_distance > max_distance)
   {
-    std::swap(bottom, top);
+    return false;
   }
 
-  // Walk along the board and if we find an occupied space, exit the loop
-  // and return false.
-  for (int i = bottom->get_y() + 1; i < top->get_y(); i++)
+  // Ensure the space ahead of the pawn is clear and vertical
+  if (is_clear_vertical(from, to) && !_position.is_occupied(to.index()))
   {
-    if (square_at(from.get_x(), i).occupied())
-    {
-      return false;
-    }
+    return true;
   }
 
-  return true;
+  // If the square is diagonally forward and occupied by an opponent
+  return move_distance == 1 && (Attacks::pawn(color, from.index()) & _position.pieces(opposite(color)) &
+                                square_bb(to.index())) != 0;
 }
 
-bool Board::is_clear_horizontal(Square const& from, Square const& to) const
+bool Board::apply_move(Square const& from, Square const& to, PieceType promotion)
 {
-  // Set up the counter for the while loop.
-  // Assume we are going to start from one space ahead of the current square
-  // and walk straight until we hit the destination square
+  Move move{from.index(), to.index()};
+  if (_position.type_on(from.index()) == PieceType::pawn && (to.get_y() == 0 || to.get_y() == c_board_dimension - 1))
+  {
+    move = Move{from.index(), to.index(), MoveType::promotion, promotion};
+  }
 
-  if (from.get_y() != to.get_y())
+  Color const mover = _position.side_to_move();
+  Undo undo;
+  _position.make_move(move, undo);
+  if (_position.is_attacked(_position.king_square(mover), opposite(mover)))
   {
+    _position.unmake_move(move, undo);
     return false;
   }
-  
-  // Set up the squares so we always walk up.
-  // So if to is above from, swap them.
-  Square const* right = &to;
-  Square const* left = &from;
-  if (to.get_x() < from.get_x())
+  return true;
+}
+
+Position const& Board::position() const
+{
+  return _position;
+}
+
+bool Board::is_clear_vertical(Square const& from, Square const& to) const
+{
+  if (from.get_x() != to.get_x())
   {
-    std::swap(left, right);
+    return false;
   }
 
-  // Walk along the board and if we find an occupied space, exit the loop
-  // and return false.
-  for (int i = left->get_x() + 1; i < right->get_x(); i++)
+  return is_clear_between_(from, to);
+}
+
+bool Board::is_clear_horizontal(Square const& from, Square const& to) const
+{
+  if (from.get_y() != to.get_y())
   {
-    if (square_at(i, from.get_y()).occupied())
-    {
-      return false;
-    }
+    return false;
   }
-  return true;
+
+  return is_clear_between_(from, to);
 }
 
 bool Board::is_clear_diagonal(Square const& from, Square const& to) const
@@ -146,51 +171,18 @@ bool Board::is_clear_diagonal(Square const& from, Square const& to) const
   {
     return false;
   }
-  
-  // Ensure we are walking right
-  Square const* left = &from;
-  Square const* right = &to;
-  if (from.get_x() > to.get_x())
-  {
-    std::swap(left, right);
-  }
 
-  // Assume that we are walking up
-  int direction = 1;
-  if (left->get_y() > right->get_y())
-  {
-    direction = -1;
-  }
+  return is_clear_between_(from, to);
+}
 
-  // Walk from "left" to "right"
-  for (int i = 1; i < right->get_x() - left->get_x(); i++)
-  {
-    // Check to see if square is occupied
-    if (Board::get_board().square_at(left->get_x() + i, left->get_y() + direction * i).occupied())
-    {
-      return false;
-    }
-  }
-  return true;
+bool Board::is_clear_between_(Square const& from, Square const& to) const
+{
+  // The squares are known to be in a line, so a single lookup gives every
+  // square that has to be empty.
+  return (Attacks::between(from.index(), to.index()) & _position.occupied()) == 0;
 }
 
 void Board::display(std::ostream& out) const
 {
-  out << std::endl;
-  for (int i = c_board_dimension - 1; i >= 0; i--)
-  {
-    out << (i + 1) << "  ";
-    for (char j = 0; j < c_board_dimension; j++)
-    {
-      square_at(j, i).display(out);
-    }
-    out << std::endl << std::endl;
-  }
-
-  out << "   ";
-  for (int i = 0; i < c_board_dimension; i++)
-  {
-    out << " " << (char)(i + 'A') << "  ";
-  }
-  std::cout << std::endl;
+  _position.display(out);
 }
@@ -0,0 +1,235 @@
+#include "book.h"
+#include "movegen.h"
+#include "position.h"
+
+namespace
+{
+// No position has more book moves than it has legal moves
+constexpr size_t c_max_book_moves{c_max_moves};
+
+// Below this many entries a BookWriter doesn't bother merging
+constexpr size_t c_min_merge_size{1 << 16};
+
+template <typename T>
+T read_big_endian(std::byte const* bytes)
+{
+  T value = 0;
+  for (size_t i = 0; i < sizeof(T); i++)
+  {
+    value = static_cast<T>((value << 8) | static_cast<T>(bytes[i]));
+  }
+  return value;
+}
+
+template <typename T>
+std::byte* write_big_endian(std::byte* bytes, T value)
+{
+  for (size_t i = sizeof(T); i-- > 0;)
+  {
+    bytes[i] = static_cast<std::byte>(value & 0xFF);
+    value = static_cast<T>(value >> 8);
+  }
+  return bytes + sizeof(T);
+}
+
+/**
+ * Orders entries by key, then the most played moves first.
+ */
+bool book_order(BookEntry const& first, BookEntry const& second)
+{
+  return (first.key != second.key) ? first.key < second.key : first.weight > second.weight;
+}
+} // namespace
+
+std::optional<OpeningBook> OpeningBook::open(std::filesystem::path const& path)
+{
+  auto file = MappedFile::open(path);
+  if (!file || file->size() % c_book_entry_size != 0)
+  {
+    return {};
+  }
+  return OpeningBook(std::move(*file));
+}
+
+bool OpeningBook::write(std::filesystem::path const& path, std::span<BookEntry const> entries)
+{
+  std::ofstream out(path, std::ios::binary);
+  for (auto const& entry : entries)
+  {
+    std::array<std::byte, c_book_entry_size> record;
+    std::byte* bytes = record.data();
+    bytes = write_big_endian(bytes, entry.key);
+    bytes = write_big_endian(bytes, entry.move.raw());
+    bytes = write_big_endian(bytes, entry.weight);
+    write_big_endian(bytes, entry.learn);
+    out.write(reinterpret_cast<char const*>(record.data()), record.size());
+  }
+  return static_cast<bool>(out);
+}
+
+size_t OpeningBook::probe(uint64_t key, std::span<BookEntry> entries) const
+{
+  size_t found = 0;
+  for (size_t index = lower_bound_(key); index < size() && found < entries.size() && key_(index) == key; index++)
+  {
+    entries[found++] = entry_(index);
+  }
+  return found;
+}
+
+Move OpeningBook::pick(Position const& position, uint64_t random) const
+{
+  std::array<BookEntry, c_max_book_moves> entries;
+  size_t const found = probe(position.hash(), entries);
+  if (found == 0)
+  {
+    return c_null_move;
+  }
+
+  // A hash collision could offer a move that can't be played here
+  MoveList legal;
+  generate_legal_moves(position, legal);
+  uint64_t total = 0;
+  for (size_t i = 0; i < found; i++)
+  {
+    if (!legal.contains(entries[i].move))
+    {
+      entries[i].weight = 0;
+    }
+    total += entries[i].weight;
+  }
+  if (total == 0)
+  {
+    return c_null_move;
+  }
+
+  uint64_t choice = random % total;
+  for (size_t i = 0; i < found; i++)
+  {
+    if (choice < entries[i].weight)
+    {
+      return entries[i].move;
+    }
+    choice -= entries[i].weight;
+  }
+  return c_null_move;
+}
+
+size_t OpeningBook::lower_bound_(uint64_t key) const
+{
+  size_t const count = size();
+  if (count == 0)
+  {
+    return 0;
+  }
+
+  // Every entry before low has a smaller key, and none from high on does.
+  // Guess from the key's share of the key space, then gallop away from the
+  // guess in doubling steps until the key is bracketed.
+  constexpr double c_key_space{18446744073709551616.0};
+  size_t const guess = std::min(static_cast<size_t>(static_cast<double>(key) / c_key_space * count), count - 1);
+  size_t low = 0;
+  size_t high = count;
+  if (key_(guess) < key)
+  {
+    low = guess + 1;
+    for (size_t step = 1; guess + step < count; step *= 2)
+    {
+      if (key_(guess + step) >= key)
+      {
+        high = guess + step;
+        break;
+      }
+      low = guess + step + 1;
+    }
+  }
+  else
+  {
+    high = guess;
+    for (size_t step = 1; step <= guess; step *= 2)
+    {
+      if (key_(guess - step) < key)
+      {
+        low = guess - step + 1;
+        break;
+      }
+      high = guess - step;
+    }
+  }
+
+  while (low < high)
+  {
+    size_t const middle = low + (high - low) / 2;
+    if (key_(middle) < key)
+    {
+      low = middle + 1;
+    }
+    else
+    {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+uint64_t OpeningBook::key_(size_t index) const
+{
+  return read_big_endian<uint64_t>(_file.bytes().data() + index * c_book_entry_size);
+}
+
+BookEntry OpeningBook::entry_(size_t index) const
+{
+  std::byte const* bytes = _file.bytes().data() + index * c_book_entry_size;
+  return {read_big_endian<uint64_t>(bytes), Move::from_raw(read_big_endian<uint16_t>(bytes + 8)),
+          read_big_endian<uint16_t>(bytes + 10), read_big_endian<uint32_t>(bytes + 12)};
+}
+
+void BookWriter::add(uint64_t key, Move move, uint16_t weight)
+{
+  _entries.push_back({key, move, weight, 0});
+  if (_entries.size() >= std::max(2 * _merged, c_min_merge_size))
+  {
+    merge_();
+  }
+}
+
+bool BookWriter::write(std::filesystem::path const& path)
+{
+  merge_();
+  std::vector<BookEntry> sorted = _entries;
+  std::sort(sorted.begin(), sorted.end(), book_order);
+  return OpeningBook::write(path, sorted);
+}
+
+size_t BookWriter::size()
+{
+  merge_();
+  return _entries.size();
+}
+
+void BookWriter::merge_()
+{
+  auto const by_move = [](BookEntry const& first, BookEntry const& second)
+  { return (first.key != second.key) ? first.key < second.key : first.move.raw() < second.move.raw(); };
+
+  auto const tail = _entries.begin() + static_cast<std::ptrdiff_t>(_merged);
+  std::sort(tail, _entries.end(), by_move);
+  std::inplace_merge(_entries.begin(), tail, _entries.end(), by_move);
+
+  // Combine repeats of the same move, without letting the weight wrap
+  size_t kept = 0;
+  for (size_t i = 0; i < _entries.size(); i++)
+  {
+    if (kept > 0 && _entries[kept - 1].key == _entries[i].key && _entries[kept - 1].move == _entries[i].move)
+    {
+      uint16_t& weight = _entries[kept - 1].weight;
+      weight = static_cast<uint16_t>(std::min<uint32_t>(weight + _entries[i].weight, UINT16_MAX));
+    }
+    else
+    {
+      _entries[kept++] = _entries[i];
+    }
+  }
+  _entries.resize(kept);
+  _merged = kept;
+}
@@ -4,34 +4,229 @@
  *
  * This is the main method for the chess game.
  * Created on March 24, 2013, 5:02 PM
+ *
+ * Usage:
+ *   chess_engine                        Play a game at the console
+ *   chess_engine --uci                  Talk to a chess GUI over UCI
+ *   chess_engine --fen "<fen>" [limits] Search one position
+ *   chess_engine --analyze [limits]     Search each FEN read from standard input
+ *
+ * Limits:
+ *   --depth <n>      Stop after n half moves
+ *   --movetime <ms>  Stop after this many milliseconds
+ *   --nodes <n>      Stop after this many nodes
+ *   --hash <mb>      The size of the transposition table (default 16)
+ *   --threads <n>    The number of search threads (default 1)
+ *   --tablebases <directory>  Score endgames from the tables in the directory
+ *
+ * Search features, all on by default:
+ *   --no-null-move   Don't prune with null moves
+ *   --no-lmr         Don't reduce late moves
+ *   --no-futility    Don't prune futile moves near the leaves
+ *   --no-razoring    Don't drop into the quiescence search early
  */
 
 #include "chess.h"
 #include "board.h"
 #include "game.h"
-#include "king.h"
-#include "pawn.h"
 #include "player.h"
+#include "search.h"
+#include "tablebase.h"
+#include "transposition_table.h"
+#include "uci.h"
 
+namespace
+{
 /**
- * Play the chess game.
- * @param argc
- * @param argv
- * @return
+ * Play the chess game at the console.
  */
-int main(int /* argc */, char* /* argv*/[])
+int play()
 {
-  Game::initialize();
+  Game game;
 
-  Board::get_board().display(std::cout);
+  game.board().display(std::cout);
 
   // Player.make_move() will return false if the player resigns
-  while (Game::get_next_player().make_move())
+  while (game.get_next_player().make_move(game.board()))
   {
-    Board::get_board().display(std::cout);
+    game.board().display(std::cout);
   }
-  Board::get_board().display(std::cout);
+  game.board().display(std::cout);
 
   std::cout << "Thanks for playing!" << std::endl;
   return 0;
 }
+
+/**
+ * Searches a position, printing each completed iteration and then the best
+ * move.
+ * @return False if the FEN could not be parsed
+ */
+bool analyze(std::string const& fen, SearchLimits const& limits, Search& search)
+{
+  auto const position = Position::from_fen(fen);
+  if (!position)
+  {
+    std::cerr << "Invalid FEN: " << fen << std::endl;
+    return false;
+  }
+
+  auto const result = search.run(*position, limits);
+  std::cout << "bestmove " << to_string(result.best_move) << std::endl;
+  return true;
+}
+
+/**
+ * Prints one completed iteration of a search.
+ */
+void print_iteration(SearchResult const& result)
+{
+  auto const millis = result.time.count();
+  std::cout << "depth " << result.depth << " score " << format_score(result.score) << " nodes " << result.nodes
+            << " nps " << ((millis > 0) ? result.nodes * 1000 / millis : 0) << " time " << millis << " pv";
+  for (auto move : result.pv)
+  {
+    std::cout << " " << to_string(move);
+  }
+  std::cout << std::endl;
+}
+
+void print_usage(std::ostream& out)
+{
+  out << "Usage:" << std::endl;
+  out << "  chess_engine" << std::endl;
+  out << "  chess_engine --uci" << std::endl;
+  out << "  chess_engine --fen \"<fen>\" [--depth <n>] [--movetime <ms>] [--nodes <n>] [--hash <mb>]"
+      << " [--threads <n>] [--tablebases <directory>] [features]" << std::endl;
+  out << "  chess_engine --analyze [--depth <n>] [--movetime <ms>] [--nodes <n>] [--hash <mb>]"
+      << " [--threads <n>] [--tablebases <directory>] [features]" << std::endl;
+  out << "Features: [--no-null-move] [--no-lmr] [--no-futility] [--no-razoring]" << std::endl;
+}
+} // namespace
+
+/**
+ * Play the chess game, or search positions given on the command line.
+ * @param argc
+ * @param argv
+ * @return
+ */
+int main(int argc, char* argv[])
+{
+  if (argc == 1)
+  {
+    return play();
+  }
+
+  if (argc == 2 && std::string_view(argv[1]) == "--uci")
+  {
+    Uci(std::cin, std::cout).run();
+    return 0;
+  }
+
+  std::optional<std::string> fen;
+  bool from_input = false;
+  SearchLimits limits;
+  size_t hash_megabytes = 16;
+  int threads = 1;
+  std::optional<std::filesystem::path> tablebase_directory;
+  SearchFeatures features;
+
+  for (int i = 1; i < argc; i++)
+  {
+    std::string const arg = argv[i];
+    if (arg == "--analyze")
+    {
+      from_input = true;
+    }
+    else if (arg == "--fen" && i + 1 < argc)
+    {
+      fen = argv[++i];
+    }
+    else if (arg == "--depth" && i + 1 < argc)
+    {
+      limits.depth = std::atoi(argv[++i]);
+    }
+    else if (arg == "--movetime" && i + 1 < argc)
+    {
+      limits.movetime = std::chrono::milliseconds(std::atoll(argv[++i]));
+    }
+    else if (arg == "--nodes" && i + 1 < argc)
+    {
+      limits.nodes = std::strtoull(argv[++i], nullptr, 10);
+    }
+    else if (arg == "--hash" && i + 1 < argc)
+    {
+      hash_megabytes = std::strtoull(argv[++i], nullptr, 10);
+    }
+    else if (arg == "--threads" && i + 1 < argc)
+    {
+      threads = std::atoi(argv[++i]);
+    }
+    else if (arg == "--tablebases" && i + 1 < argc)
+    {
+      tablebase_directory = argv[++i];
+    }
+    else if (arg == "--no-null-move")
+    {
+      features.null_move = false;
+    }
+    else if (arg == "--no-lmr")
+    {
+      features.late_move_reductions = false;
+    }
+    else if (arg == "--no-futility")
+    {
+      features.futility_pruning = false;
+    }
+    else if (arg == "--no-razoring")
+    {
+      features.razoring = false;
+    }
+    else
+    {
+      print_usage(std::cerr);
+      return 1;
+    }
+  }
+
+  if (fen.has_value() == from_input)
+  {
+    print_usage(std::cerr);
+    return 1;
+  }
+
+  // Without a limit the search would never finish
+  if (limits.depth == 0 && limits.nodes == 0 && limits.movetime.count() == 0)
+  {
+    limits.depth = 6;
+  }
+
+  TranspositionTable table(hash_megabytes);
+  Search search(table, threads);
+  search.set_iteration_callback(print_iteration);
+  search.set_features(features);
+
+  Tablebases tablebases;
+  if (tablebase_directory && tablebases.add_directory(*tablebase_directory) == 0)
+  {
+    std::cerr << "No tablebases in " << tablebase_directory->string() << std::endl;
+    return 1;
+  }
+  search.set_tablebases(&tablebases);
+  if (fen)
+  {
+    return analyze(*fen, limits, search) ? 0 : 1;
+  }
+
+  int failures = 0;
+  std::string line;
+  while (std::getline(std::cin, line))
+  {
+    if (!line.empty())
+    {
+      failures += analyze(line, limits, search) ? 0 : 1;
+      std::cout << std::endl;
+    }
+  }
+  return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,15 @@
+#include "evaluate.h"
+#include "pawns.h"
+#include "position.h"
+
+int evaluate(Position const& position, PawnCache& pawns)
+{
+  PawnEntry const& structure = pawns.probe(position);
+  Score psq = position.piece_square_score();
+  psq += structure.score;
+  psq.mg += structure.king_shelter(position, Color::white) - structure.king_shelter(position, Color::black);
+
+  int const phase = std::min(position.phase(), c_max_phase);
+  int const score = (psq.mg * phase + psq.eg * (c_max_phase - phase)) / c_max_phase;
+  return (position.side_to_move() == Color::white) ? score : -score;
+}
@@ -0,0 +1,117 @@
+#include "mapped_file.h"
+
+#if defined(_WIN32)
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+std::optional<MappedFile> MappedFile::open(std::filesystem::path const& path)
+{
+  std::error_code error;
+  size_t const size = std::filesystem::file_size(path, error);
+  if (error)
+  {
+    return {};
+  }
+
+  // An empty file can't be mapped, but there is nothing to read anyway
+  if (size == 0)
+  {
+    return MappedFile(nullptr, 0);
+  }
+
+#if defined(_WIN32)
+  HANDLE const file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    return {};
+  }
+  HANDLE const mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (mapping == nullptr)
+  {
+    return {};
+  }
+  void const* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (data == nullptr)
+  {
+    return {};
+  }
+#else
+  int const file = ::open(path.c_str(), O_RDONLY);
+  if (file < 0)
+  {
+    return {};
+  }
+  void const* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+  close(file);
+  if (data == MAP_FAILED)
+  {
+    return {};
+  }
+#endif
+
+  return MappedFile(static_cast<std::byte const*>(data), size);
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : _data(std::exchange(other._data, nullptr)), _size(std::exchange(other._size, 0))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+  std::swap(_data, other._data);
+  std::swap(_size, other._size);
+  return *this;
+}
+
+MappedFile::~MappedFile()
+{
+  if (_data == nullptr)
+  {
+    return;
+  }
+#if defined(_WIN32)
+  UnmapViewOfFile(_data);
+#else
+  munmap(const_cast<std::byte*>(_data), _size);
+#endif
+}
+
+void MappedFile::advise_sequential() const
+{
+#if !defined(_WIN32)
+  if (_data != nullptr)
+  {
+    madvise(const_cast<std::byte*>(_data), _size, MADV_SEQUENTIAL);
+  }
+#endif
+}
+
+void MappedFile::release(size_t offset, size_t length) const
+{
+#if !defined(_WIN32)
+  // Pages are released whole. A page that straddles the end of the range
+  // is kept, but one straddling the start is released: reading it again
+  // only faults it back in from the file.
+  size_t const page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size_t const start = offset / page * page;
+  size_t const end = std::min(offset + length, _size) / page * page;
+  if (_data != nullptr && start < end)
+  {
+    madvise(const_cast<std::byte*>(_data) + start, end - start, MADV_DONTNEED);
+  }
+#else
+  (void)offset;
+  (void)length;
+#endif
+}
@@ -0,0 +1,26 @@
+#include "move.h"
+
+namespace
+{
+constexpr std::array<char, c_num_piece_types> c_promotion_letters{'p', 'n', 'b', 'r', 'q', 'k'};
+} // namespace
+
+std::string square_name(int square)
+{
+  return {static_cast<char>('a' + file_of(square)), static_cast<char>('1' + rank_of(square))};
+}
+
+std::string to_string(Move move)
+{
+  if (move == c_null_move)
+  {
+    return "0000";
+  }
+
+  std::string result = square_name(move.from()) + square_name(move.to());
+  if (move.type() == MoveType::promotion)
+  {
+    result += c_promotion_letters[index_of(move.promotion())];
+  }
+  return result;
+}
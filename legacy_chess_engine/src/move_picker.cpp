@@ -0,0 +1,201 @@
+#include "move_picker.h"
+#include "evaluate.h"
+#include "movegen.h"
+#include "see.h"
+
+namespace
+{
+// Spaces the victims' values far enough apart that the attacker only
+// breaks ties between equal victims
+constexpr int c_victim_scale{16};
+} // namespace
+
+void HistoryTable::age()
+{
+  for (auto& side : _scores)
+  {
+    for (auto& from : side)
+    {
+      for (int& score : from)
+      {
+        score /= 2;
+      }
+    }
+  }
+}
+
+MovePicker::MovePicker(Position const& position, Move tt_move, Killers const& killers, HistoryTable const& history)
+  : _position(position), _history(history), _tt_move(tt_move), _killers(killers)
+{
+}
+
+MovePicker::MovePicker(Position const& position, HistoryTable const& history)
+  : _position(position), _history(history), _tt_move(c_null_move), _killers{c_null_move, c_null_move},
+    _stage(Stage::captures), _captures_only(true)
+{
+}
+
+Move MovePicker::next()
+{
+  switch (_stage)
+  {
+  case Stage::tt_move:
+    _stage = Stage::captures;
+    if (_tt_move != c_null_move)
+    {
+      // The move may come from another position with the same hash, so it
+      // is checked against the moves of its stage before it is trusted
+      bool const quiet = is_quiet(_position, _tt_move);
+      if (quiet)
+      {
+        generate_quiets_();
+      }
+      else
+      {
+        generate_captures_();
+      }
+      if ((quiet ? _quiets : _captures).contains(_tt_move))
+      {
+        return _tt_move;
+      }
+    }
+    [[fallthrough]];
+
+  case Stage::captures:
+    if (!_captures_generated)
+    {
+      generate_captures_();
+    }
+    if (Move const move = pick_good_capture_(); move != c_null_move)
+    {
+      return move;
+    }
+    if (_captures_only)
+    {
+      _stage = Stage::done;
+      break;
+    }
+    _stage = Stage::killers;
+    [[fallthrough]];
+
+  case Stage::killers:
+    while (_next_killer < static_cast<int>(_killers.size()))
+    {
+      Move const killer = _killers[_next_killer++];
+      if (killer == c_null_move || killer == _tt_move)
+      {
+        continue;
+      }
+      if (!_quiets_generated)
+      {
+        generate_quiets_();
+      }
+      if (_quiets.contains(killer))
+      {
+        return killer;
+      }
+    }
+    _stage = Stage::quiets;
+    [[fallthrough]];
+
+  case Stage::quiets:
+    if (!_quiets_generated)
+    {
+      generate_quiets_();
+    }
+    if (Move const move = pick_best_(_quiets, _next_quiet, true); move != c_null_move)
+    {
+      return move;
+    }
+    _stage = Stage::bad_captures;
+    [[fallthrough]];
+
+  case Stage::bad_captures:
+    // These were set aside in order, best first
+    if (_next_bad_capture < _bad_captures.size())
+    {
+      return _bad_captures[_next_bad_capture++];
+    }
+    _stage = Stage::done;
+    [[fallthrough]];
+
+  case Stage::done:
+    break;
+  }
+  return c_null_move;
+}
+
+void MovePicker::generate_captures_()
+{
+  generate_legal_captures(_position, _captures);
+  _captures_generated = true;
+
+  for (int i = 0; i < _captures.size(); i++)
+  {
+    Move const move = _captures[i];
+    int gain = 0;
+    if (move.type() == MoveType::en_passant)
+    {
+      gain = c_piece_values[index_of(PieceType::pawn)];
+    }
+    else if (_position.is_occupied(move.to()))
+    {
+      gain = c_piece_values[index_of(_position.type_on(move.to()))];
+    }
+    if (move.type() == MoveType::promotion)
+    {
+      gain += c_piece_values[index_of(move.promotion())];
+    }
+    _captures.score(i) = gain * c_victim_scale - c_piece_values[index_of(_position.type_on(move.from()))];
+  }
+}
+
+void MovePicker::generate_quiets_()
+{
+  generate_legal_quiets(_position, _quiets);
+  _quiets_generated = true;
+
+  Color const us = _position.side_to_move();
+  for (int i = 0; i < _quiets.size(); i++)
+  {
+    _quiets.score(i) = _history.score(us, _quiets[i]);
+  }
+}
+
+Move MovePicker::pick_good_capture_()
+{
+  for (Move move = pick_best_(_captures, _next_capture, false); move != c_null_move;
+       move = pick_best_(_captures, _next_capture, false))
+  {
+    if (static_exchange(_position, move) >= 0)
+    {
+      return move;
+    }
+    _bad_captures.push_back(move);
+  }
+  return c_null_move;
+}
+
+Move MovePicker::pick_best_(MoveList& moves, int& next, bool skip_killers)
+{
+  while (next < moves.size())
+  {
+    int best = next;
+    for (int i = next + 1; i < moves.size(); i++)
+    {
+      if (moves.score(i) > moves.score(best))
+      {
+        best = i;
+      }
+    }
+    moves.swap(next, best);
+
+    Move const move = moves[next++];
+    bool const returned = (move == _tt_move) || (skip_killers && (move == _killers[0] || move == _killers[1]));
+    if (!returned)
+    {
+      return move;
+    }
+  }
+  return c_null_move;
+}
@@ -0,0 +1,376 @@
+#include "movegen.h"
+#include "attacks.h"
+#include "position.h"
+
+namespace
+{
+constexpr std::array<PieceType, 4> c_promotion_types{PieceType::queen, PieceType::rook, PieceType::bishop,
+                                                     PieceType::knight};
+
+/**
+ * Which moves to generate. Captures means every capture and promotion,
+ * quiets everything else.
+ */
+enum class Generate : uint8_t
+{
+  captures,
+  quiets,
+  all
+};
+
+/**
+ * Adds the move of a pawn to the list, expanding it into the four possible
+ * promotions if the pawn reaches the last row.
+ */
+void add_pawn_move(int from, int to, MoveList& moves)
+{
+  if (rank_of(to) == 0 || rank_of(to) == 7)
+  {
+    for (auto type : c_promotion_types)
+    {
+      moves.push_back(Move{from, to, MoveType::promotion, type});
+    }
+  }
+  else
+  {
+    moves.push_back(Move{from, to});
+  }
+}
+
+/**
+ * Adds a move from the square to each of the targets.
+ */
+void add_moves(int from, Bitboard targets, MoveList& moves)
+{
+  while (targets)
+  {
+    moves.push_back(Move{from, pop_lsb(targets)});
+  }
+}
+
+/**
+ * What every move generated at a node has to respect, worked out once from
+ * the checkers and pins rather than by trying each move.
+ */
+struct LegalMasks
+{
+  int king;
+  Bitboard targets; // Where pieces other than the king may move to
+  Bitboard pinned;  // Pieces that may only move along the line to their king
+};
+
+/**
+ * @return The squares a piece on from may move to without exposing its king
+ */
+Bitboard pin_mask(LegalMasks const& masks, int from)
+{
+  return (masks.pinned & square_bb(from)) ? Attacks::line(masks.king, from) : ~Bitboard{0};
+}
+
+/**
+ * Checks an en passant capture by working out the occupancy after it. Two
+ * pawns leave the king's row at once, which pins can't describe, so this is
+ * the one move that is tested directly.
+ */
+bool is_en_passant_safe(Position const& position, int from, int to)
+{
+  Color const us = position.side_to_move();
+  Bitboard const captured = square_bb(square_index(file_of(to), rank_of(from)));
+  Bitboard const occupied = (position.occupied() ^ square_bb(from) ^ captured) | square_bb(to);
+  int const king = position.king_square(us);
+  return (position.attackers_to(king, occupied) & position.pieces(opposite(us)) & ~captured) == 0;
+}
+
+/**
+ * @return The bitboard moved by a signed number of squares, as a shift left
+ * for positive steps and right for negative ones
+ */
+template <int Step>
+constexpr Bitboard shift(Bitboard bb)
+{
+  return (Step > 0) ? (bb << Step) : (bb >> -Step);
+}
+
+template <Color Us, Generate Type>
+void generate_pawn_moves(Position const& position, LegalMasks const& masks, MoveList& moves)
+{
+  // Every direction and row is fixed for the side, so the shifts below are
+  // constants and the loops carry no color branches
+  constexpr int up = (Us == Color::white) ? 8 : -8;
+  constexpr int up_left = (Us == Color::white) ? 7 : -9;
+  constexpr int up_right = (Us == Color::white) ? 9 : -7;
+  constexpr Bitboard third_rank = (Us == Color::white) ? (c_rank_1_bb << 16) : (c_rank_1_bb << 40);
+  constexpr Bitboard start_rank = (Us == Color::white) ? (c_rank_1_bb << 8) : (c_rank_1_bb << 48);
+  constexpr Bitboard last_rank = (Us == Color::white) ? c_rank_8_bb : c_rank_1_bb;
+
+  // Pushes onto the last rank promote, so they count as captures
+  constexpr Bitboard push_targets = (Type == Generate::captures) ? last_rank
+                                    : (Type == Generate::quiets) ? ~last_rank
+                                                                 : ~c_empty_bb;
+  constexpr bool with_captures = (Type != Generate::quiets);
+
+  Bitboard const empty = ~position.occupied();
+  Bitboard const enemies = position.pieces(opposite(Us));
+  Bitboard const pawns = position.pieces(PieceType::pawn, Us);
+  Bitboard const free_pawns = pawns & ~masks.pinned;
+
+  // Pushes and captures are generated for all unpinned pawns at once by
+  // shifting the whole set. Only the destination needs to block a check, so
+  // the mask is applied after the double push is worked out from the single.
+  Bitboard single = shift<up>(free_pawns) & empty;
+  Bitboard twice = (Type == Generate::captures) ? 0 : shift<up>(single & third_rank) & empty & masks.targets;
+  single &= masks.targets & push_targets;
+
+  Bitboard const capturable = with_captures ? (enemies & masks.targets) : 0;
+  Bitboard left = shift<up_left>(free_pawns) & ~c_file_h_bb & capturable;
+  Bitboard right = shift<up_right>(free_pawns) & ~c_file_a_bb & capturable;
+
+  while (single)
+  {
+    int const to = pop_lsb(single);
+    add_pawn_move(to - up, to, moves);
+  }
+
+  while (twice)
+  {
+    int const to = pop_lsb(twice);
+    moves.push_back(Move{to - 2 * up, to});
+  }
+
+  while (left)
+  {
+    int const to = pop_lsb(left);
+    add_pawn_move(to - up_left, to, moves);
+  }
+
+  while (right)
+  {
+    int const to = pop_lsb(right);
+    add_pawn_move(to - up_right, to, moves);
+  }
+
+  // A pinned pawn can still move along the pin: forward on its own column,
+  // or capturing the pinning piece on a diagonal
+  Bitboard pinned_pawns = pawns & masks.pinned;
+  while (pinned_pawns)
+  {
+    int const from = pop_lsb(pinned_pawns);
+    Bitboard const allowed = masks.targets & Attacks::line(masks.king, from);
+
+    Bitboard captures = Attacks::pawn(Us, from) & capturable & allowed;
+    while (captures)
+    {
+      add_pawn_move(from, pop_lsb(captures), moves);
+    }
+
+    int const to = from + up;
+    if (empty & square_bb(to))
+    {
+      if (allowed & push_targets & square_bb(to))
+      {
+        add_pawn_move(from, to, moves);
+      }
+      if (Type != Generate::captures && (start_rank & square_bb(from)) && (empty & allowed & square_bb(to + up)))
+      {
+        moves.push_back(Move{from, to + up});
+      }
+    }
+  }
+
+  int const en_passant = position.en_passant_square();
+  if (with_captures && en_passant != c_no_square)
+  {
+    // The pawns that could capture are those a pawn of the other color on
+    // the en passant square would attack
+    Bitboard capturers = Attacks::pawn(opposite(Us), en_passant) & pawns;
+    while (capturers)
+    {
+      int const from = pop_lsb(capturers);
+      if (is_en_passant_safe(position, from, en_passant))
+      {
+        moves.push_back(Move{from, en_passant, MoveType::en_passant});
+      }
+    }
+  }
+}
+
+template <Color Us>
+void generate_piece_moves(Position const& position, LegalMasks const& masks, MoveList& moves)
+{
+  Bitboard const occupied = position.occupied();
+
+  // A pinned knight can never stay on the line to its king
+  Bitboard knights = position.pieces(PieceType::knight, Us) & ~masks.pinned;
+  while (knights)
+  {
+    int const from = pop_lsb(knights);
+    add_moves(from, Attacks::knight(from) & masks.targets, moves);
+  }
+
+  Bitboard bishops = position.pieces(PieceType::bishop, Us);
+  while (bishops)
+  {
+    int const from = pop_lsb(bishops);
+    add_moves(from, Attacks::bishop(from, occupied) & masks.targets & pin_mask(masks, from), moves);
+  }
+
+  Bitboard rooks = position.pieces(PieceType::rook, Us);
+  while (rooks)
+  {
+    int const from = pop_lsb(rooks);
+    add_moves(from, Attacks::rook(from, occupied) & masks.targets & pin_mask(masks, from), moves);
+  }
+
+  Bitboard queens = position.pieces(PieceType::queen, Us);
+  while (queens)
+  {
+    int const from = pop_lsb(queens);
+    add_moves(from, Attacks::queen(from, occupied) & masks.targets & pin_mask(masks, from), moves);
+  }
+}
+
+/**
+ * Adds the king's steps to squares no enemy piece attacks. The king is
+ * taken off the board first so it can't hide behind itself from a slider.
+ * @param allowed The squares to consider stepping to
+ */
+template <Color Us>
+void generate_king_moves(Position const& position, Bitboard allowed, MoveList& moves)
+{
+  Bitboard const enemies = position.pieces(opposite(Us));
+  int const king = position.king_square(Us);
+  Bitboard const occupied = position.occupied() ^ square_bb(king);
+
+  Bitboard targets = Attacks::king(king) & allowed;
+  while (targets)
+  {
+    int const to = pop_lsb(targets);
+    if (!(position.attackers_to(to, occupied) & enemies))
+    {
+      moves.push_back(Move{king, to});
+    }
+  }
+}
+
+/**
+ * Adds the castling moves for the side to move, which must not be in check.
+ * These are only generated when they are fully legal: the king and rook are
+ * on their starting squares, the squares between them are empty, and the
+ * king does not pass through an attacked square. Positions set up by hand
+ * can carry rights whose king or rook is gone, so the pieces are checked
+ * rather than assumed.
+ */
+template <Color Us>
+void generate_castling_moves(Position const& position, MoveList& moves)
+{
+  constexpr Color them = opposite(Us);
+  constexpr uint8_t kingside = (Us == Color::white) ? c_castle_white_kingside : c_castle_black_kingside;
+  constexpr uint8_t queenside = (Us == Color::white) ? c_castle_white_queenside : c_castle_black_queenside;
+  constexpr int king = square_index(4, (Us == Color::white) ? 0 : 7);
+  constexpr Piece rook = make_piece(Us, PieceType::rook);
+
+  if (!(position.castling_rights() & (kingside | queenside)) ||
+      position.piece_on(king) != make_piece(Us, PieceType::king))
+  {
+    return;
+  }
+
+  if ((position.castling_rights() & kingside) && position.piece_on(king + 3) == rook &&
+      !(Attacks::between(king, king + 3) & position.occupied()) &&
+      !position.is_attacked(king + 1, them) && !position.is_attacked(king + 2, them))
+  {
+    moves.push_back(Move{king, king + 2, MoveType::castling});
+  }
+
+  if ((position.castling_rights() & queenside) && position.piece_on(king - 4) == rook &&
+      !(Attacks::between(king, king - 4) & position.occupied()) &&
+      !position.is_attacked(king - 1, them) && !position.is_attacked(king - 2, them))
+  {
+    moves.push_back(Move{king, king - 2, MoveType::castling});
+  }
+}
+/**
+ * Generates the legal moves for one side, so that every color dependent
+ * shift and mask is a compile time constant.
+ */
+template <Color Us, Generate Type>
+void generate_moves(Position const& position, MoveList& moves)
+{
+  // The squares captures and quiet moves may go to, before checks and pins
+  Bitboard const allowed = (Type == Generate::captures) ? position.pieces(opposite(Us))
+                           : (Type == Generate::quiets) ? ~position.occupied()
+                                                        : ~position.pieces(Us);
+
+  generate_king_moves<Us>(position, allowed, moves);
+
+  // In double check only the king can move
+  Bitboard const checkers = position.checkers();
+  if (more_than_one(checkers))
+  {
+    return;
+  }
+
+  int const king = position.king_square(Us);
+
+  // In check, everything else must capture the checker or step in between
+  LegalMasks masks{king, ~position.pieces(Us), position.pinned(Us)};
+  if (checkers)
+  {
+    masks.targets &= checkers | Attacks::between(king, lsb(checkers));
+  }
+
+  // Pawns work out their own targets, since their pushes and captures go
+  // to different squares and promotions count as captures
+  generate_pawn_moves<Us, Type>(position, masks, moves);
+  masks.targets &= allowed;
+  generate_piece_moves<Us>(position, masks, moves);
+
+  if (Type != Generate::captures && !checkers)
+  {
+    generate_castling_moves<Us>(position, moves);
+  }
+}
+
+template <Generate Type>
+void generate(Position const& position, MoveList& moves)
+{
+  moves.clear();
+  if (position.side_to_move() == Color::white)
+  {
+    generate_moves<Color::white, Type>(position, moves);
+  }
+  else
+  {
+    generate_moves<Color::black, Type>(position, moves);
+  }
+}
+} // namespace
+
+void generate_legal_moves(Position const& position, MoveList& moves)
+{
+  generate<Generate::all>(position, moves);
+}
+
+void generate_legal_captures(Position const& position, MoveList& moves)
+{
+  generate<Generate::captures>(position, moves);
+}
+
+void generate_legal_quiets(Position const& position, MoveList& moves)
+{
+  generate<Generate::quiets>(position, moves);
+}
+
+Move parse_move(Position const& position, std::string_view text)
+{
+  MoveList moves;
+  generate_legal_moves(position, moves);
+  for (Move move : moves)
+  {
+    if (to_string(move) == text)
+    {
+      return move;
+    }
+  }
+  return c_null_move;
+}
@@ -0,0 +1,154 @@
+#include "pawns.h"
+#include "attacks.h"
+
+namespace
+{
+// By the pawn's rank counted from its own side, rank 2 being 1
+constexpr std::array<Score, 8> c_passed_pawn{
+  {{0, 0}, {5, 10}, {10, 20}, {15, 35}, {25, 60}, {40, 100}, {60, 150}, {0, 0}}};
+
+constexpr Score c_isolated_pawn{-10, -15};
+constexpr Score c_doubled_pawn{-10, -20};
+constexpr Score c_backward_pawn{-8, -10};
+
+// For each file next to or in front of the king, middlegame only
+constexpr int c_shelter_pawn_near{15};
+constexpr int c_shelter_pawn_far{8};
+constexpr int c_shelter_missing{-15};
+
+constexpr std::array<Bitboard, 8> c_files = []
+{
+  std::array<Bitboard, 8> files{};
+  for (int x = 0; x < 8; x++)
+  {
+    files[x] = c_file_a_bb << x;
+  }
+  return files;
+}();
+
+constexpr std::array<Bitboard, 8> c_adjacent_files = []
+{
+  std::array<Bitboard, 8> files{};
+  for (int x = 0; x < 8; x++)
+  {
+    files[x] = ((x > 0) ? c_files[x - 1] : 0) | ((x < 7) ? c_files[x + 1] : 0);
+  }
+  return files;
+}();
+
+/**
+ * @return The ranks strictly in front of a rank, from the side's point of
+ * view
+ */
+constexpr Bitboard ranks_ahead(Color color, int rank)
+{
+  if (color == Color::white)
+  {
+    return (rank >= 7) ? 0 : ~Bitboard{0} << (8 * (rank + 1));
+  }
+  return (rank <= 0) ? 0 : ~Bitboard{0} >> (8 * (8 - rank));
+}
+
+/**
+ * @return The sum of the side's pawn terms, positive when good for the side
+ */
+Score side_structure(Position const& position, Color color)
+{
+  Bitboard const ours = position.pieces(PieceType::pawn, color);
+  Bitboard const theirs = position.pieces(PieceType::pawn, opposite(color));
+  int const forward = (color == Color::white) ? 8 : -8;
+
+  Score score;
+  Bitboard pawns = ours;
+  while (pawns)
+  {
+    int const square = pop_lsb(pawns);
+    int const x = file_of(square);
+    int const y = rank_of(square);
+    Bitboard const ahead = ranks_ahead(color, y);
+
+    bool const doubled = (ours & c_files[x] & ahead) != 0;
+    bool const isolated = (ours & c_adjacent_files[x]) == 0;
+    if (doubled)
+    {
+      score += c_doubled_pawn;
+    }
+    if (isolated)
+    {
+      score += c_isolated_pawn;
+    }
+
+    // The front pawn of a doubled pair counts as passed, the other doesn't
+    if (!doubled && (theirs & (c_files[x] | c_adjacent_files[x]) & ahead) == 0)
+    {
+      score += c_passed_pawn[(color == Color::white) ? y : 7 - y];
+    }
+
+    // No pawn beside or behind can ever protect it, and an enemy pawn stops
+    // it from advancing to safety
+    if (!isolated && (ours & c_adjacent_files[x] & ~ahead) == 0 &&
+        (Attacks::pawn(color, square + forward) & theirs) != 0)
+    {
+      score += c_backward_pawn;
+    }
+  }
+  return score;
+}
+
+/**
+ * @return The shelter bonus of the side's pawns for its king on each file
+ */
+std::array<int16_t, 8> side_shelter(Position const& position, Color color)
+{
+  Bitboard const ours = position.pieces(PieceType::pawn, color);
+  int const near_rank = (color == Color::white) ? 1 : 6;
+  int const far_rank = (color == Color::white) ? 2 : 5;
+
+  std::array<int, 8> by_file{};
+  for (int x = 0; x < 8; x++)
+  {
+    if (ours & square_bb(square_index(x, near_rank)))
+    {
+      by_file[x] = c_shelter_pawn_near;
+    }
+    else if (ours & square_bb(square_index(x, far_rank)))
+    {
+      by_file[x] = c_shelter_pawn_far;
+    }
+    else
+    {
+      by_file[x] = c_shelter_missing;
+    }
+  }
+
+  std::array<int16_t, 8> shelter{};
+  for (int king_file = 0; king_file < 8; king_file++)
+  {
+    int total = 0;
+    for (int x = std::max(king_file - 1, 0); x <= std::min(king_file + 1, 7); x++)
+    {
+      total += by_file[x];
+    }
+    shelter[king_file] = static_cast<int16_t>(total);
+  }
+  return shelter;
+}
+} // namespace
+
+PawnEntry evaluate_pawns(Position const& position)
+{
+  PawnEntry entry;
+  entry.key = position.pawn_hash();
+  entry.score = side_structure(position, Color::white);
+  entry.score -= side_structure(position, Color::black);
+  entry.shelter[index_of(Color::white)] = side_shelter(position, Color::white);
+  entry.shelter[index_of(Color::black)] = side_shelter(position, Color::black);
+  return entry;
+}
+
+PawnCache::PawnCache()
+{
+  // Every slot starts out holding the structure without pawns, whose key is
+  // 0, so an empty slot never passes for another structure
+  _entries.assign(c_pawn_cache_entries, evaluate_pawns(Position()));
+}
@@ -0,0 +1,25 @@
+#include "perft.h"
+#include "movegen.h"
+#include "position.h"
+
+uint64_t perft(Position& position, int depth)
+{
+  MoveList moves;
+  generate_legal_moves(position, moves);
+
+  // The moves at the last ply don't need to be played to be counted
+  if (depth <= 1)
+  {
+    return (depth == 1) ? moves.size() : 1;
+  }
+
+  uint64_t nodes = 0;
+  Undo undo;
+  for (auto move : moves)
+  {
+    position.make_move(move, undo);
+    nodes += perft(position, depth - 1);
+    position.unmake_move(move, undo);
+  }
+  return nodes;
+}
@@ -0,0 +1,178 @@
+#include "pgn.h"
+#include "san.h"
+
+namespace
+{
+/**
+ * @return True if the line is empty or only whitespace
+ */
+bool is_blank(std::string_view line)
+{
+  return std::all_of(line.begin(), line.end(), [](char c) { return c == ' ' || c == '\t' || c == '\r'; });
+}
+
+/**
+ * @return The value of a tag line such as [Result "1-0"], or empty if the
+ * line isn't the named tag
+ */
+std::optional<std::string_view> tag_value(std::string_view line, std::string_view name)
+{
+  if (line.size() < name.size() + 2 || line.substr(1, name.size()) != name || line[name.size() + 1] != ' ')
+  {
+    return {};
+  }
+  size_t const open = line.find('"');
+  size_t const close = line.rfind('"');
+  if (open == std::string_view::npos || close <= open)
+  {
+    return {};
+  }
+  return line.substr(open + 1, close - open - 1);
+}
+
+/**
+ * @return True if the token ends the movetext of a game
+ */
+bool is_termination(std::string_view token)
+{
+  return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*";
+}
+} // namespace
+
+size_t next_pgn_game(std::string_view text, size_t from)
+{
+  bool seen_movetext = false;
+  while (from < text.size())
+  {
+    size_t const end = std::min(text.find('\n', from), text.size());
+    std::string_view const line = text.substr(from, end - from);
+    if (!line.empty() && line.front() == '[')
+    {
+      if (seen_movetext)
+      {
+        return from;
+      }
+    }
+    else if (!is_blank(line))
+    {
+      seen_movetext = true;
+    }
+    from = end + 1;
+  }
+  return text.size();
+}
+
+PgnGame read_pgn_game(std::string_view game, std::function<bool(Position const&, Move)> const& on_move)
+{
+  PgnGame result;
+  Position& position = result.position;
+  Undo undo;
+
+  size_t i = 0;
+  while (i < game.size())
+  {
+    char const c = game[i];
+    bool const line_start = (i == 0 || game[i - 1] == '\n');
+    if (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '.')
+    {
+      i++;
+    }
+    else if (line_start && (c == '[' || c == '%'))
+    {
+      size_t const end = std::min(game.find('\n', i), game.size());
+      std::string_view const line = game.substr(i, end - i);
+      if (auto const value = tag_value(line, "Result"))
+      {
+        result.result = *value;
+      }
+      else if (auto const fen = tag_value(line, "FEN"))
+      {
+        auto const start = Position::from_fen(*fen);
+        if (!start)
+        {
+          result.error = "invalid FEN";
+          break;
+        }
+        position = *start;
+      }
+      i = end;
+    }
+    else if (c == '{')
+    {
+      i = std::min(game.find('}', i), game.size()) + 1;
+    }
+    else if (c == ';')
+    {
+      i = std::min(game.find('\n', i), game.size());
+    }
+    else if (c == '(')
+    {
+      // Variations nest, and may hold comments with brackets of their own
+      int depth = 0;
+      for (; i < game.size(); i++)
+      {
+        if (game[i] == '{')
+        {
+          i = std::min(game.find('}', i), game.size());
+        }
+        else if (game[i] == '(')
+        {
+          depth++;
+        }
+        else if (game[i] == ')' && --depth == 0)
+        {
+          break;
+        }
+      }
+      i++;
+    }
+    else
+    {
+      size_t end = i;
+      while (end < game.size() && game[end] > ' ' && game[end] != '{' && game[end] != '(' && game[end] != ';')
+      {
+        end++;
+      }
+      std::string_view token = game.substr(i, end - i);
+      i = end;
+
+      if (token.front() == '$' || token == ")")
+      {
+        continue;
+      }
+      if (is_termination(token))
+      {
+        break;
+      }
+
+      // Move numbers may run straight into the move, as in "12.e4"
+      if (token.front() >= '1' && token.front() <= '9')
+      {
+        size_t const dot = token.rfind('.');
+        if (dot == std::string_view::npos)
+        {
+          continue;
+        }
+        token.remove_prefix(dot + 1);
+        if (token.empty())
+        {
+          continue;
+        }
+      }
+
+      Move const move = parse_san(position, token);
+      if (move == c_null_move)
+      {
+        result.error = "cannot play " + std::string(token);
+        break;
+      }
+      if (on_move && !on_move(position, move))
+      {
+        break;
+      }
+      position.make_move(move, undo);
+      result.plies++;
+    }
+  }
+  return result;
+}
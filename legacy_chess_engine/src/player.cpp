@@ -1,18 +1,39 @@
 #include "player.h"
 #include "board.h"
-#include "piece.h"
+#include "evaluate.h"
 #include "square.h"
 
-class Piece;
+namespace
+{
+/**
+ * @param letter The letter typed after a move, in either case
+ * @return The piece a pawn can promote to that the letter names, or empty
+ */
+std::optional<PieceType> promotion_piece(char letter)
+{
+  switch (std::toupper(static_cast<unsigned char>(letter)))
+  {
+  case 'Q':
+    return PieceType::queen;
+  case 'R':
+    return PieceType::rook;
+  case 'B':
+    return PieceType::bishop;
+  case 'N':
+    return PieceType::knight;
+  default:
+    return {};
+  }
+}
+} // namespace
 
-Player::Player(std::string name, King& my_king)
-    : _name(std::move(name)), _king(&my_king)
+Player::Player(std::string name, Color color) : _name(std::move(name)), _color(color)
 {
 }
 
 Player::~Player() = default;
 
-bool Player::make_move()
+bool Player::make_move(Board& board)
 {
   bool valid_move = false;
   bool still_playing = true;
@@ -27,17 +48,22 @@ bool Player::make_move()
     {
       still_playing = false;
     }
-    else if (Board::get_board().square_at(move->first.get_x(), move->first.get_y()).occupied())
+    else if (Piece const occupier = board.piece_on(move->from); occupier != Piece::none)
     {
-      Piece* occupier = &Board::get_board().square_at(move->first.get_x(), move->first.get_y()).occupied_by();
-
-      if (my_pieces().find(occupier) == my_pieces().end())
+      if (color_of(occupier) != _color)
       {
         std::cout << "Please move one of your own pieces." << std::endl;
       }
       else
       {
-        valid_move = occupier->move_to(*this, (move->second));
+        // The move takes whatever stands on the destination square
+        Piece const target = board.piece_on(move->to);
+        valid_move =
+            board.can_move(move->from, move->to) && board.apply_move(move->from, move->to, move->promotion);
+        if (valid_move && target != Piece::none)
+        {
+          capture(target);
+        }
         if (!valid_move)
         {
           std::cout << "please enter a valid move for the piece, and ";
@@ -55,11 +81,11 @@ bool Player::make_move()
 }
 
 // Returns empty if the player resigns.
-std::optional<std::pair<Square, Square>> Player::prompt_move_(std::istream& in, std::ostream& out)
+std::optional<Player::RequestedMove> Player::prompt_move_(std::istream& in, std::ostream& out)
 {
   std::string line = "";
   out << get_name() + ", please enter the beginning and ending squares of the ";
-  out << "move (ex: A2 A4): ";
+  out << "move (ex: A2 A4, or A7 A8 N to promote to a knight): ";
 
   // Get move from the user and ensure that it is of the correct form
   getline(in, line);
@@ -84,12 +110,14 @@ std::optional<std::pair<Square, Square>> Player::prompt_move_(std::istream& in,
       line[3] = line[3] - 32;
     }
 
-    // Create a std::pair of squares to return, representing the beginning and
-    // ending squares of the desired move. Subtract 48 and 65 from the lines
-    // since they are read as ascii values from the console
-    // (so '0' is 48 and 'A' is 65), but we want to store them as integers,
-    // so we can do array access.
-    return std::pair<Square, Square>{{line[0] - 'A', line[1] - '0' - 1}, {line[3] - 'A', line[4] - '0' - 1}};
+    // Pawns become queens unless the player asks for something else
+    PieceType const promotion = (line.length() == 7) ? *promotion_piece(line[6]) : PieceType::queen;
+
+    // Create the beginning and ending squares of the desired move. Subtract
+    // 48 and 65 from the lines since they are read as ascii values from the
+    // console (so '0' is 48 and 'A' is 65), but we want to store them as
+    // integers, so we can do array access.
+    return RequestedMove{{line[0] - 'A', line[1] - '0' - 1}, {line[3] - 'A', line[4] - '0' - 1}, promotion};
   }
 
   // Empty if the player resigned
@@ -101,12 +129,12 @@ bool Player::is_valid_(const std::string& line)
   bool result = true;
 
   // If any character does not  fall in the allowed range,
-  // the std::string is invalid. (valid: "A2 A3")
+  // the std::string is invalid. (valid: "A2 A3" or "A7 A8 N")
   // Also, "quit" is a valid input.
 
   // Make sure the std::string is the correct length. This also uses short
   // circuiting to protect the std::string from bounds errors.
-  if (line != "quit" && (line.length() != 5 ||
+  if (line != "quit" && ((line.length() != 5 && line.length() != 7) ||
 
                          // 'A' <= line[0] <= 'H'
                          !((line[0] >= 'A' && line[0] <= 'H') || (line[0] >= 'a' && line[0] <= 'h')) ||
@@ -121,7 +149,10 @@ bool Player::is_valid_(const std::string& line)
                          !((line[3] >= 'A' && line[3] <= 'H') || (line[3] >= 'a' && line[3] <= 'h')) ||
 
                          // '1' <= line[4] <= '8'
-                         line[4] < '1' || line[4] > '8'))
+                         line[4] < '1' || line[4] > '8' ||
+
+                         // An optional space and promotion piece: Q, R, B or N
+                         (line.length() == 7 && (line[5] != ' ' || !promotion_piece(line[6])))))
   {
     result = false;
   }
@@ -136,30 +167,21 @@ std::string& Player::get_name()
 
 int Player::score()
 {
-  return 0;
-}
-
-void Player::capture(Piece& a_piece)
-{
-  _captured.insert(&a_piece);
-}
-
-void Player::uncapture(Piece& a_piece)
-{
-  _captured.erase(&a_piece);
-}
-
-std::set<Piece*>& Player::my_pieces()
-{
-  return const_cast<std::set<Piece*>&>(std::as_const(*this).my_pieces());
+  // Counted in pawns, as the pieces have always been scored
+  int total = 0;
+  for (auto piece : _captured)
+  {
+    total += c_piece_values[index_of(type_of(piece))] / c_piece_values[index_of(PieceType::pawn)];
+  }
+  return total;
 }
 
-std::set<Piece*> const& Player::my_pieces() const
+void Player::capture(Piece a_piece)
 {
-  return _pieces;
+  _captured.push_back(a_piece);
 }
 
-King& Player::my_king() const
+Color Player::color() const
 {
-  return *_king;
+  return _color;
 }
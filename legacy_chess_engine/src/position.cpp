@@ -0,0 +1,743 @@
+#include "position.h"
+#include "attacks.h"
+#include "zobrist.h"
+
+namespace
+{
+// The half move clock is a byte, and stops here rather than wrapping to 0,
+// which would undo a fifty move draw
+constexpr int c_max_halfmove_clock{255};
+
+constexpr std::array<char, c_num_piece_types> c_piece_letters{'P', 'N', 'B', 'R', 'Q', 'K'};
+
+// The piece each FEN letter stands for, indexed by character
+constexpr std::array<Piece, 256> c_pieces_by_letter = []
+{
+  std::array<Piece, 256> pieces{};
+  for (int type = 0; type < c_num_piece_types; type++)
+  {
+    char const letter = c_piece_letters[type];
+    pieces[static_cast<unsigned char>(letter)] = make_piece(Color::white, static_cast<PieceType>(type));
+    pieces[static_cast<unsigned char>(letter - 'A' + 'a')] = make_piece(Color::black, static_cast<PieceType>(type));
+  }
+  return pieces;
+}();
+
+/**
+ * Splits the next field off a FEN record, skipping the whitespace before it.
+ * @param rest The rest of the record, which loses the field
+ * @return The field, or empty at the end of the record
+ */
+std::string_view next_field(std::string_view& rest)
+{
+  // Scanning by hand is several times faster than find_first_of, and treats
+  // tabs and line endings as separators too
+  size_t start = 0;
+  while (start < rest.size() && rest[start] <= ' ')
+  {
+    start++;
+  }
+  size_t end = start;
+  while (end < rest.size() && rest[end] > ' ')
+  {
+    end++;
+  }
+  std::string_view const field = rest.substr(start, end - start);
+  rest.remove_prefix(end);
+  return field;
+}
+
+/**
+ * Reads a whole field as a non-negative number.
+ * @return False if the field is not a number
+ */
+bool parse_number(std::string_view field, int& value)
+{
+  auto const [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+  return error == std::errc{} && end == field.data() + field.size() && value >= 0;
+}
+
+constexpr std::array<PieceType, 8> c_back_rank{PieceType::rook,  PieceType::knight, PieceType::bishop,
+                                               PieceType::queen, PieceType::king,   PieceType::bishop,
+                                               PieceType::knight, PieceType::rook};
+
+/**
+ * The castling rights that survive a piece moving from or to each square.
+ * Moving the king or a rook, or capturing a rook on its starting square,
+ * loses the matching rights.
+ */
+constexpr std::array<uint8_t, c_num_squares> c_castling_masks = []
+{
+  std::array<uint8_t, c_num_squares> masks{};
+  masks.fill(c_castle_all);
+  masks[square_index(0, 0)] &= ~c_castle_white_queenside;
+  masks[square_index(7, 0)] &= ~c_castle_white_kingside;
+  masks[square_index(4, 0)] &= ~(c_castle_white_kingside | c_castle_white_queenside);
+  masks[square_index(0, 7)] &= ~c_castle_black_queenside;
+  masks[square_index(7, 7)] &= ~c_castle_black_kingside;
+  masks[square_index(4, 7)] &= ~(c_castle_black_kingside | c_castle_black_queenside);
+  return masks;
+}();
+
+/**
+ * The side and rook corner of each castling right. The king must be on its
+ * starting square too.
+ */
+constexpr std::array<std::tuple<uint8_t, Color, int>, 4> c_castling_rooks{
+  {{c_castle_white_kingside, Color::white, square_index(7, 0)},
+   {c_castle_white_queenside, Color::white, square_index(0, 0)},
+   {c_castle_black_kingside, Color::black, square_index(7, 7)},
+   {c_castle_black_queenside, Color::black, square_index(0, 7)}}};
+
+/**
+ * @param king_to The square a castling king moves to
+ * @return The squares the rook moves from and to
+ */
+constexpr std::pair<int, int> castling_rook_squares(int king_to)
+{
+  // Kingside castling moves the king towards column H
+  if (file_of(king_to) == 6)
+  {
+    return {king_to + 1, king_to - 1};
+  }
+  return {king_to - 2, king_to + 1};
+}
+} // namespace
+
+Position::Position() = default;
+
+Position Position::start_position()
+{
+  Position position;
+  for (int x = 0; x < 8; x++)
+  {
+    position.put_piece(c_back_rank[x], Color::white, square_index(x, 0));
+    position.put_piece(PieceType::pawn, Color::white, square_index(x, 1));
+    position.put_piece(PieceType::pawn, Color::black, square_index(x, 6));
+    position.put_piece(c_back_rank[x], Color::black, square_index(x, 7));
+  }
+  position.set_castling_rights(c_castle_all);
+  return position;
+}
+
+std::optional<Position> Position::from_fen(std::string_view fen)
+{
+  Position position;
+  std::string_view placement = next_field(fen);
+  std::string_view const side = next_field(fen);
+  std::string_view const castling = next_field(fen);
+  std::string_view const en_passant = next_field(fen);
+  std::string_view const halfmove = next_field(fen);
+  std::string_view const fullmove = next_field(fen);
+  if (placement.empty() || !next_field(fen).empty())
+  {
+    return {};
+  }
+
+  // Rows are listed from 8 down to 1, each from column A to H
+  int x = 0;
+  int y = 7;
+  for (char c : placement)
+  {
+    if (c == '/')
+    {
+      if (x != 8 || y == 0)
+      {
+        return {};
+      }
+      x = 0;
+      y--;
+    }
+    else if (c >= '1' && c <= '8')
+    {
+      x += c - '0';
+      if (x > 8)
+      {
+        return {};
+      }
+    }
+    else
+    {
+      Piece const piece = c_pieces_by_letter[static_cast<unsigned char>(c)];
+      if (piece == Piece::none || x > 7)
+      {
+        return {};
+      }
+      position.put_piece(type_of(piece), color_of(piece), square_index(x, y));
+      x++;
+    }
+  }
+
+  if (x != 8 || y != 0 || pop_count(position.pieces(PieceType::king, Color::white)) != 1 ||
+      pop_count(position.pieces(PieceType::king, Color::black)) != 1 ||
+      (position.pieces(PieceType::pawn) & (c_rank_1_bb | c_rank_8_bb)))
+  {
+    return {};
+  }
+
+  if (side == "b")
+  {
+    position.set_side_to_move(Color::black);
+  }
+  else if (!side.empty() && side != "w")
+  {
+    return {};
+  }
+  Color const us = position.side_to_move();
+
+  uint8_t rights = 0;
+  for (char c : castling)
+  {
+    switch (c)
+    {
+    case 'K':
+      rights |= c_castle_white_kingside;
+      break;
+    case 'Q':
+      rights |= c_castle_white_queenside;
+      break;
+    case 'k':
+      rights |= c_castle_black_kingside;
+      break;
+    case 'q':
+      rights |= c_castle_black_queenside;
+      break;
+    case '-':
+      break;
+    default:
+      return {};
+    }
+  }
+
+  // A right whose king or rook has moved can never be used, and make_move
+  // counts on both pieces being there, so it is dropped
+  for (auto const& [right, color, rook] : c_castling_rooks)
+  {
+    int const king = square_index(4, (color == Color::white) ? 0 : 7);
+    if (position.piece_on(king) != make_piece(color, PieceType::king) ||
+        position.piece_on(rook) != make_piece(color, PieceType::rook))
+    {
+      rights &= ~right;
+    }
+  }
+  position.set_castling_rights(rights);
+
+  if (!en_passant.empty() && en_passant != "-")
+  {
+    if (en_passant.length() != 2 || en_passant[0] < 'a' || en_passant[0] > 'h' ||
+        (en_passant[1] != '3' && en_passant[1] != '6'))
+    {
+      return {};
+    }
+
+    // As in make_move, the square is only recorded if a pawn could capture
+    // on it, so the hash matches the same position reached by play. The
+    // pawn that just moved two squares must be there, with the squares it
+    // crossed empty, or the capture would remove a piece that isn't there.
+    int const square = square_index(en_passant[0] - 'a', en_passant[1] - '1');
+    int const capture_rank = (us == Color::white) ? 5 : 2;
+    int const forward = (us == Color::white) ? 8 : -8;
+    if (rank_of(square) == capture_rank &&
+        position.piece_on(square - forward) == make_piece(opposite(us), PieceType::pawn) &&
+        !position.is_occupied(square) && !position.is_occupied(square + forward) &&
+        (Attacks::pawn(opposite(us), square) & position.pieces(PieceType::pawn, us)))
+    {
+      position.set_en_passant_square(square);
+    }
+  }
+
+  int clock = 0;
+  int number = 1;
+  if ((!halfmove.empty() && !parse_number(halfmove, clock)) || (!fullmove.empty() && !parse_number(fullmove, number)))
+  {
+    return {};
+  }
+  position.set_halfmove_clock(clock);
+  position.set_fullmove_number(std::clamp(number, 1, 0xFFFF));
+
+  // A position where the side that just moved is still in check can't
+  // arise in a game, and the search can't make sense of it
+  if (position.is_attacked(position.king_square(opposite(us)), us))
+  {
+    return {};
+  }
+
+  position.update_checkers();
+  return position;
+}
+
+char* Position::write_fen(char* out) const
+{
+  for (int y = 7; y >= 0; y--)
+  {
+    int empty = 0;
+    for (int x = 0; x < 8; x++)
+    {
+      Piece const piece = _mailbox[square_index(x, y)];
+      if (piece == Piece::none)
+      {
+        empty++;
+        continue;
+      }
+      if (empty > 0)
+      {
+        *out++ = static_cast<char>('0' + empty);
+        empty = 0;
+      }
+      char const letter = c_piece_letters[index_of(type_of(piece))];
+      *out++ = (color_of(piece) == Color::white) ? letter : static_cast<char>(letter - 'A' + 'a');
+    }
+    if (empty > 0)
+    {
+      *out++ = static_cast<char>('0' + empty);
+    }
+    if (y > 0)
+    {
+      *out++ = '/';
+    }
+  }
+
+  *out++ = ' ';
+  *out++ = (_side_to_move == Color::white) ? 'w' : 'b';
+
+  *out++ = ' ';
+  if (_castling_rights == 0)
+  {
+    *out++ = '-';
+  }
+  else
+  {
+    constexpr std::array<std::pair<uint8_t, char>, 4> c_castling_letters{{{c_castle_white_kingside, 'K'},
+                                                                         {c_castle_white_queenside, 'Q'},
+                                                                         {c_castle_black_kingside, 'k'},
+                                                                         {c_castle_black_queenside, 'q'}}};
+    for (auto const& [right, letter] : c_castling_letters)
+    {
+      if (_castling_rights & right)
+      {
+        *out++ = letter;
+      }
+    }
+  }
+
+  *out++ = ' ';
+  if (_en_passant_square == c_no_square)
+  {
+    *out++ = '-';
+  }
+  else
+  {
+    *out++ = static_cast<char>('a' + file_of(_en_passant_square));
+    *out++ = static_cast<char>('1' + rank_of(_en_passant_square));
+  }
+
+  // Each clock has at most five digits
+  *out++ = ' ';
+  out = std::to_chars(out, out + 5, _halfmove_clock).ptr;
+  *out++ = ' ';
+  out = std::to_chars(out, out + 5, _fullmove_number).ptr;
+  return out;
+}
+
+std::string Position::to_fen() const
+{
+  std::array<char, c_max_fen_length> buffer;
+  return std::string(buffer.data(), write_fen(buffer.data()));
+}
+
+Bitboard Position::attackers_to(int square, Bitboard occupied) const
+{
+  Bitboard const rooks_queens = pieces(PieceType::rook) | pieces(PieceType::queen);
+  Bitboard const bishops_queens = pieces(PieceType::bishop) | pieces(PieceType::queen);
+
+  // A pawn attacks the square if a pawn of the other color on the square
+  // would attack the pawn.
+  return (Attacks::pawn(Color::black, square) & pieces(PieceType::pawn, Color::white)) |
+         (Attacks::pawn(Color::white, square) & pieces(PieceType::pawn, Color::black)) |
+         (Attacks::knight(square) & pieces(PieceType::knight)) | (Attacks::king(square) & pieces(PieceType::king)) |
+         (Attacks::rook(square, occupied) & rooks_queens) | (Attacks::bishop(square, occupied) & bishops_queens);
+}
+
+Bitboard Position::pinned(Color color) const
+{
+  int const king = king_square(color);
+  Bitboard const enemies = pieces(opposite(color));
+
+  // Enemy sliders that would attack the king if nothing stood in the way
+  Bitboard snipers = ((Attacks::rook(king, 0) & (pieces(PieceType::rook) | pieces(PieceType::queen))) |
+                      (Attacks::bishop(king, 0) & (pieces(PieceType::bishop) | pieces(PieceType::queen)))) &
+                     enemies;
+
+  Bitboard result = 0;
+  Bitboard const occupied_squares = occupied();
+  while (snipers)
+  {
+    Bitboard const blockers = Attacks::between(king, pop_lsb(snipers)) & occupied_squares;
+    if (blockers && !more_than_one(blockers))
+    {
+      result |= blockers & pieces(color);
+    }
+  }
+  return result;
+}
+
+void Position::update_checkers()
+{
+  Color const them = opposite(_side_to_move);
+  _checkers = attackers_to(king_square(_side_to_move), occupied()) & pieces(them);
+}
+
+uint64_t Position::compute_hash() const
+{
+  uint64_t hash = 0;
+  Bitboard occupied_squares = occupied();
+  while (occupied_squares)
+  {
+    int const square = pop_lsb(occupied_squares);
+    hash ^= c_zobrist.pieces[index_of(color_on(square))][index_of(type_on(square))][square];
+  }
+
+  hash ^= c_zobrist.castling[_castling_rights];
+  if (_en_passant_square != c_no_square)
+  {
+    hash ^= c_zobrist.en_passant_file[file_of(_en_passant_square)];
+  }
+  if (_side_to_move == Color::black)
+  {
+    hash ^= c_zobrist.black_to_move;
+  }
+  return hash;
+}
+
+uint64_t Position::compute_pawn_hash() const
+{
+  uint64_t hash = 0;
+  for (Color const color : {Color::white, Color::black})
+  {
+    Bitboard pawns = pieces(PieceType::pawn, color);
+    while (pawns)
+    {
+      hash ^= c_zobrist.pieces[index_of(color)][index_of(PieceType::pawn)][pop_lsb(pawns)];
+    }
+  }
+  return hash;
+}
+
+Score Position::compute_piece_square_score() const
+{
+  Score score;
+  Bitboard occupied_squares = occupied();
+  while (occupied_squares)
+  {
+    int const square = pop_lsb(occupied_squares);
+    score += c_piece_square[index_of(color_on(square))][index_of(type_on(square))][square];
+  }
+  return score;
+}
+
+void Position::put_piece(PieceType type, Color color, int square)
+{
+  Bitboard const bb = square_bb(square);
+  _by_type[index_of(type)] |= bb;
+  _by_color[index_of(color)] |= bb;
+  _mailbox[square] = make_piece(color, type);
+  _hash ^= c_zobrist.pieces[index_of(color)][index_of(type)][square];
+  if (type == PieceType::pawn)
+  {
+    _pawn_hash ^= c_zobrist.pieces[index_of(color)][index_of(type)][square];
+  }
+  _piece_square += c_piece_square[index_of(color)][index_of(type)][square];
+  _phase += c_phase_weights[index_of(type)];
+}
+
+void Position::remove_piece(int square)
+{
+  Bitboard const bb = square_bb(square);
+  PieceType const type = type_on(square);
+  Color const color = color_on(square);
+  _by_type[index_of(type)] &= ~bb;
+  _by_color[index_of(color)] &= ~bb;
+  _mailbox[square] = Piece::none;
+  _hash ^= c_zobrist.pieces[index_of(color)][index_of(type)][square];
+  if (type == PieceType::pawn)
+  {
+    _pawn_hash ^= c_zobrist.pieces[index_of(color)][index_of(type)][square];
+  }
+  _piece_square -= c_piece_square[index_of(color)][index_of(type)][square];
+  _phase -= c_phase_weights[index_of(type)];
+}
+
+void Position::move_piece(int from, int to)
+{
+  Bitboard const from_to = square_bb(from) | square_bb(to);
+  PieceType const type = type_on(from);
+  Color const color = color_on(from);
+  _by_type[index_of(type)] ^= from_to;
+  _by_color[index_of(color)] ^= from_to;
+  _mailbox[to] = _mailbox[from];
+  _mailbox[from] = Piece::none;
+  _hash ^= c_zobrist.pieces[index_of(color)][index_of(type)][from] ^
+           c_zobrist.pieces[index_of(color)][index_of(type)][to];
+  if (type == PieceType::pawn)
+  {
+    _pawn_hash ^= c_zobrist.pieces[index_of(color)][index_of(type)][from] ^
+                  c_zobrist.pieces[index_of(color)][index_of(type)][to];
+  }
+  _piece_square -= c_piece_square[index_of(color)][index_of(type)][from];
+  _piece_square += c_piece_square[index_of(color)][index_of(type)][to];
+}
+
+void Position::change_type_(int square, PieceType type)
+{
+  Bitboard const bb = square_bb(square);
+  PieceType const old_type = type_on(square);
+  Color const color = color_on(square);
+  _by_type[index_of(old_type)] ^= bb;
+  _by_type[index_of(type)] ^= bb;
+  _mailbox[square] = make_piece(color, type);
+  _hash ^= c_zobrist.pieces[index_of(color)][index_of(old_type)][square] ^
+           c_zobrist.pieces[index_of(color)][index_of(type)][square];
+
+  // A pawn promoting, or the promotion being taken back
+  _pawn_hash ^= c_zobrist.pieces[index_of(color)][index_of(PieceType::pawn)][square];
+  _piece_square -= c_piece_square[index_of(color)][index_of(old_type)][square];
+  _piece_square += c_piece_square[index_of(color)][index_of(type)][square];
+  _phase += c_phase_weights[index_of(type)] - c_phase_weights[index_of(old_type)];
+}
+
+void Position::make_move(Move move, Undo& undo)
+{
+  Color const us = _side_to_move;
+  Color const them = opposite(us);
+  int const from = move.from();
+  int const to = move.to();
+
+  undo.is_capture = false;
+  undo.castling_rights = _castling_rights;
+  undo.en_passant_square = _en_passant_square;
+  undo.halfmove_clock = _halfmove_clock;
+  undo.hash = _hash;
+  undo.checkers = _checkers;
+
+  if (_en_passant_square != c_no_square)
+  {
+    _hash ^= c_zobrist.en_passant_file[file_of(_en_passant_square)];
+    _en_passant_square = c_no_square;
+  }
+  _halfmove_clock = static_cast<uint8_t>(std::min(_halfmove_clock + 1, c_max_halfmove_clock));
+
+  if (move.type() == MoveType::castling)
+  {
+    auto const [rook_from, rook_to] = castling_rook_squares(to);
+    move_piece(from, to);
+    move_piece(rook_from, rook_to);
+  }
+  else
+  {
+    bool const is_pawn = (pieces(PieceType::pawn) & square_bb(from)) != 0;
+
+    if (move.type() == MoveType::en_passant)
+    {
+      undo.is_capture = true;
+      undo.captured = PieceType::pawn;
+      remove_piece(square_index(file_of(to), rank_of(from)));
+    }
+    else if (is_occupied(to))
+    {
+      undo.is_capture = true;
+      undo.captured = type_on(to);
+      remove_piece(to);
+    }
+
+    move_piece(from, to);
+
+    if (move.type() == MoveType::promotion)
+    {
+      change_type_(to, move.promotion());
+    }
+
+    if (is_pawn || undo.is_capture)
+    {
+      _halfmove_clock = 0;
+    }
+
+    // Only record the en passant square if a pawn could actually capture on
+    // it, so that identical positions compare equal.
+    if (is_pawn && std::abs(to - from) == 16)
+    {
+      int const skipped = (from + to) / 2;
+      if (Attacks::pawn(us, skipped) & pieces(PieceType::pawn, them))
+      {
+        _en_passant_square = static_cast<uint8_t>(skipped);
+        _hash ^= c_zobrist.en_passant_file[file_of(skipped)];
+      }
+    }
+  }
+
+  uint8_t const rights = _castling_rights & c_castling_masks[from] & c_castling_masks[to];
+  _hash ^= c_zobrist.castling[_castling_rights] ^ c_zobrist.castling[rights];
+  _castling_rights = rights;
+
+  if (us == Color::black)
+  {
+    _fullmove_number++;
+  }
+  _side_to_move = them;
+  _hash ^= c_zobrist.black_to_move;
+  update_checkers();
+}
+
+void Position::unmake_move(Move move, Undo const& undo)
+{
+  Color const us = opposite(_side_to_move);
+  int const from = move.from();
+  int const to = move.to();
+
+  _side_to_move = us;
+  if (us == Color::black)
+  {
+    _fullmove_number--;
+  }
+
+  if (move.type() == MoveType::castling)
+  {
+    auto const [rook_from, rook_to] = castling_rook_squares(to);
+    move_piece(to, from);
+    move_piece(rook_to, rook_from);
+  }
+  else
+  {
+    if (move.type() == MoveType::promotion)
+    {
+      change_type_(to, PieceType::pawn);
+    }
+
+    move_piece(to, from);
+
+    if (move.type() == MoveType::en_passant)
+    {
+      put_piece(PieceType::pawn, opposite(us), square_index(file_of(to), rank_of(from)));
+    }
+    else if (undo.is_capture)
+    {
+      put_piece(undo.captured, opposite(us), to);
+    }
+  }
+
+  _castling_rights = undo.castling_rights;
+  _en_passant_square = undo.en_passant_square;
+  _halfmove_clock = undo.halfmove_clock;
+
+  // The piece moves above updated the hash too, but restoring it is cheaper
+  // than undoing the castling, en passant and side to move keys one by one.
+  _hash = undo.hash;
+  _checkers = undo.checkers;
+}
+
+void Position::make_null_move(Undo& undo)
+{
+  undo.is_capture = false;
+  undo.castling_rights = _castling_rights;
+  undo.en_passant_square = _en_passant_square;
+  undo.halfmove_clock = _halfmove_clock;
+  undo.hash = _hash;
+  undo.checkers = _checkers;
+
+  if (_en_passant_square != c_no_square)
+  {
+    _hash ^= c_zobrist.en_passant_file[file_of(_en_passant_square)];
+    _en_passant_square = c_no_square;
+  }
+  _halfmove_clock = static_cast<uint8_t>(std::min(_halfmove_clock + 1, c_max_halfmove_clock));
+
+  if (_side_to_move == Color::black)
+  {
+    _fullmove_number++;
+  }
+  _side_to_move = opposite(_side_to_move);
+  _hash ^= c_zobrist.black_to_move;
+
+  // The side now to move wasn't to move before, so it can't be in check
+  _checkers = 0;
+}
+
+void Position::unmake_null_move(Undo const& undo)
+{
+  _side_to_move = opposite(_side_to_move);
+  if (_side_to_move == Color::black)
+  {
+    _fullmove_number--;
+  }
+  _en_passant_square = undo.en_passant_square;
+  _halfmove_clock = undo.halfmove_clock;
+  _hash = undo.hash;
+  _checkers = undo.checkers;
+}
+
+void Position::set_side_to_move(Color color)
+{
+  if (color != _side_to_move)
+  {
+    _hash ^= c_zobrist.black_to_move;
+  }
+  _side_to_move = color;
+}
+
+void Position::set_castling_rights(uint8_t rights)
+{
+  _hash ^= c_zobrist.castling[_castling_rights] ^ c_zobrist.castling[rights];
+  _castling_rights = rights;
+}
+
+void Position::set_en_passant_square(int square)
+{
+  if (_en_passant_square != c_no_square)
+  {
+    _hash ^= c_zobrist.en_passant_file[file_of(_en_passant_square)];
+  }
+  if (square != c_no_square)
+  {
+    _hash ^= c_zobrist.en_passant_file[file_of(square)];
+  }
+  _en_passant_square = static_cast<uint8_t>(square);
+}
+
+void Position::set_halfmove_clock(int halfmoves)
+{
+  _halfmove_clock = static_cast<uint8_t>(std::min(halfmoves, c_max_halfmove_clock));
+}
+
+void Position::set_fullmove_number(int number)
+{
+  _fullmove_number = static_cast<uint16_t>(number);
+}
+
+void Position::display(std::ostream& out) const
+{
+  out << std::endl;
+  for (int y = 7; y >= 0; y--)
+  {
+    out << (y + 1) << "  ";
+    for (int x = 0; x < 8; x++)
+    {
+      int const square = square_index(x, y);
+      if (is_occupied(square))
+      {
+        char const color = (color_on(square) == Color::white) ? 'w' : 'b';
+        out << c_piece_letters[index_of(type_on(square))] << "_" << color << " ";
+      }
+      else
+      {
+        out << "___ ";
+      }
+    }
+    out << std::endl << std::endl;
+  }
+
+  out << "   ";
+  for (int x = 0; x < 8; x++)
+  {
+    out << " " << static_cast<char>(x + 'A') << "  ";
+  }
+  out << std::endl;
+}
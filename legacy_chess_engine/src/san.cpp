@@ -0,0 +1,249 @@
+#include "san.h"
+#include "attacks.h"
+#include "movegen.h"
+#include "position.h"
+
+namespace
+{
+/**
+ * @param letter An upper case piece letter
+ * @return The piece type, or empty if the letter isn't a piece
+ */
+std::optional<PieceType> piece_from_letter(char letter)
+{
+  switch (letter)
+  {
+  case 'N':
+    return PieceType::knight;
+  case 'B':
+    return PieceType::bishop;
+  case 'R':
+    return PieceType::rook;
+  case 'Q':
+    return PieceType::queen;
+  case 'K':
+    return PieceType::king;
+  default:
+    return {};
+  }
+}
+
+/**
+ * @return The only legal move that passes the filter, or c_null_move if
+ * there are none or several
+ */
+template <typename Filter>
+Move find_unique_legal(Position const& position, Filter filter)
+{
+  MoveList moves;
+  generate_legal_moves(position, moves);
+  Move found = c_null_move;
+  for (Move move : moves)
+  {
+    if (filter(move))
+    {
+      if (found != c_null_move)
+      {
+        return c_null_move;
+      }
+      found = move;
+    }
+  }
+  return found;
+}
+
+/**
+ * @param piece The type of piece
+ * @param to A square
+ * @return The squares from which a piece of that type attacks the square
+ */
+Bitboard attackers_of_type(Position const& position, PieceType piece, int to)
+{
+  switch (piece)
+  {
+  case PieceType::knight:
+    return Attacks::knight(to);
+  case PieceType::bishop:
+    return Attacks::bishop(to, position.occupied());
+  case PieceType::rook:
+    return Attacks::rook(to, position.occupied());
+  case PieceType::queen:
+    return Attacks::queen(to, position.occupied());
+  default:
+    return Attacks::king(to);
+  }
+}
+
+/**
+ * Checks that a move the piece's movement rules allow doesn't leave its own
+ * king in check. Castling and en passant need more care, and aren't handled.
+ */
+bool keeps_king_safe(Position const& position, int from, int to)
+{
+  Color const us = position.side_to_move();
+  Color const them = opposite(us);
+  int const king = position.king_square(us);
+  if (from == king)
+  {
+    // Slide attacks through the king's old square, which it is leaving
+    return !(position.attackers_to(to, position.occupied() ^ square_bb(from)) & position.pieces(them));
+  }
+
+  Bitboard const checkers = position.checkers();
+  if (more_than_one(checkers) ||
+      (checkers && !((checkers | Attacks::between(king, lsb(checkers))) & square_bb(to))))
+  {
+    return false;
+  }
+  return !(position.pinned(us) & square_bb(from)) || (Attacks::line(king, from) & square_bb(to));
+}
+} // namespace
+
+Move parse_san(Position const& position, std::string_view san)
+{
+  while (!san.empty() && (san.back() == '+' || san.back() == '#' || san.back() == '!' || san.back() == '?'))
+  {
+    san.remove_suffix(1);
+  }
+  if (san.size() < 2)
+  {
+    return c_null_move;
+  }
+
+  if (san == "O-O" || san == "0-0" || san == "O-O-O" || san == "0-0-0")
+  {
+    // Castling is stored as the king's move, two columns either way
+    int const king_to_file = (san.size() == 3) ? 6 : 2;
+    return find_unique_legal(position, [&](Move move)
+                             { return move.type() == MoveType::castling && file_of(move.to()) == king_to_file; });
+  }
+
+  // Anything that doesn't start with a piece letter is a pawn move
+  PieceType piece = PieceType::pawn;
+  if (auto const letter = piece_from_letter(san.front()))
+  {
+    piece = *letter;
+    san.remove_prefix(1);
+  }
+
+  std::optional<PieceType> promotion;
+  if (piece == PieceType::pawn)
+  {
+    if (auto const letter = piece_from_letter(san.back()); letter && *letter != PieceType::king)
+    {
+      promotion = letter;
+      san.remove_suffix(1);
+      if (!san.empty() && san.back() == '=')
+      {
+        san.remove_suffix(1);
+      }
+    }
+  }
+
+  if (san.size() < 2)
+  {
+    return c_null_move;
+  }
+  char const to_file = san[san.size() - 2];
+  char const to_rank = san[san.size() - 1];
+  if (to_file < 'a' || to_file > 'h' || to_rank < '1' || to_rank > '8')
+  {
+    return c_null_move;
+  }
+  int const to = square_index(to_file - 'a', to_rank - '1');
+  san.remove_suffix(2);
+
+  // Whatever is left picks out the moving piece by its column, row or both
+  int from_file = -1;
+  int from_rank = -1;
+  for (char c : san)
+  {
+    if (c >= 'a' && c <= 'h')
+    {
+      from_file = c - 'a';
+    }
+    else if (c >= '1' && c <= '8')
+    {
+      from_rank = c - '1';
+    }
+    else if (c != 'x' && c != '-')
+    {
+      return c_null_move;
+    }
+  }
+
+  Color const us = position.side_to_move();
+  Color const them = opposite(us);
+  Bitboard const target = square_bb(to);
+  if (position.pieces(us) & target)
+  {
+    return c_null_move;
+  }
+
+  // Work back from the target square to the pieces that could have moved
+  // there, rather than generating every move
+  Bitboard candidates;
+  MoveType type = MoveType::normal;
+  if (piece == PieceType::pawn)
+  {
+    if (to == position.en_passant_square())
+    {
+      return find_unique_legal(position, [&](Move move)
+                               { return move.type() == MoveType::en_passant && file_of(move.from()) == from_file &&
+                                        move.to() == to; });
+    }
+
+    int const forward = (us == Color::white) ? 8 : -8;
+    if (from_file >= 0)
+    {
+      // Only captures name the pawn's column
+      candidates = (position.pieces(them) & target) ? Attacks::pawn(them, to) : c_empty_bb;
+    }
+    else if (!(position.occupied() & target))
+    {
+      int const one_step = to - forward;
+      int const double_rank = (us == Color::white) ? 3 : 4;
+      if (one_step >= 0 && one_step < c_num_squares && position.is_occupied(one_step))
+      {
+        candidates = square_bb(one_step);
+      }
+      else
+      {
+        candidates = (rank_of(to) == double_rank) ? square_bb(to - 2 * forward) : c_empty_bb;
+      }
+    }
+    else
+    {
+      candidates = c_empty_bb;
+    }
+
+    bool const last_rank = (rank_of(to) == ((us == Color::white) ? 7 : 0));
+    if (last_rank != promotion.has_value())
+    {
+      return c_null_move;
+    }
+    type = last_rank ? MoveType::promotion : MoveType::normal;
+  }
+  else
+  {
+    candidates = attackers_of_type(position, piece, to);
+  }
+  candidates &= position.pieces(piece, us);
+
+  Move found = c_null_move;
+  while (candidates)
+  {
+    int const from = pop_lsb(candidates);
+    if ((from_file >= 0 && file_of(from) != from_file) || (from_rank >= 0 && rank_of(from) != from_rank) ||
+        !keeps_king_safe(position, from, to))
+    {
+      continue;
+    }
+    if (found != c_null_move)
+    {
+      return c_null_move;
+    }
+    found = Move(from, to, type, promotion.value_or(PieceType::knight));
+  }
+  return found;
+}
@@ -0,0 +1,798 @@
+#include "search.h"
+#include "evaluate.h"
+#include "move_picker.h"
+#include "movegen.h"
+#include "pawns.h"
+#include "tablebase.h"
+#include "transposition_table.h"
+
+namespace
+{
+// How often, in nodes, the clock is checked
+constexpr uint64_t c_limit_check_interval{1024};
+
+constexpr int c_aspiration_window{25};
+constexpr int c_aspiration_min_depth{5};
+
+// The null move search is this much shallower, plus a quarter of the depth
+constexpr int c_null_move_reduction{3};
+constexpr int c_null_move_min_depth{3};
+
+// Deeper null move cutoffs are checked by a search without null moves,
+// which catches the zugzwang positions where passing would be best
+constexpr int c_null_move_verify_depth{10};
+
+// Margins per ply of remaining depth
+constexpr int c_futility_max_depth{3};
+constexpr int c_futility_margin{150};
+constexpr int c_razoring_max_depth{2};
+constexpr int c_razoring_margin{300};
+
+// Late move reductions start after the first few moves, and a history score
+// this large makes the reduction one ply smaller
+constexpr int c_reduction_min_depth{3};
+constexpr int c_reduction_min_moves{3};
+constexpr int c_reduction_history_step{c_max_history / 2};
+constexpr int c_reduction_table_size{64};
+
+/**
+ * The late move reduction by depth and move number. It grows with both,
+ * since deep searches and late moves are where a well ordered search is
+ * least likely to find anything.
+ */
+auto const c_reductions = []
+{
+  std::array<std::array<int, c_reduction_table_size>, c_reduction_table_size> reductions{};
+  for (int depth = 1; depth < c_reduction_table_size; depth++)
+  {
+    for (int moves = 1; moves < c_reduction_table_size; moves++)
+    {
+      reductions[depth][moves] = static_cast<int>(0.75 + std::log(depth) * std::log(moves) / 2.25);
+    }
+  }
+  return reductions;
+}();
+
+/**
+ * Mate scores are stored relative to the position they were found in, rather
+ * than to the root, so they stay correct when the position is reached at a
+ * different ply.
+ */
+int score_to_table(int score, int ply)
+{
+  if (score >= c_mate_bound)
+  {
+    return score + ply;
+  }
+  if (score <= -c_mate_bound)
+  {
+    return score - ply;
+  }
+  return score;
+}
+
+int score_from_table(int score, int ply)
+{
+  if (score >= c_mate_bound)
+  {
+    return score - ply;
+  }
+  if (score <= -c_mate_bound)
+  {
+    return score + ply;
+  }
+  return score;
+}
+
+/**
+ * Scores a tablebase result like a mate found by the search. A mate too far
+ * away to have a mate score is still scored above any evaluation.
+ */
+int score_from_tablebase(TablebaseResult result, int ply)
+{
+  if (result.wdl == Wdl::draw)
+  {
+    return 0;
+  }
+  int const mate_ply = ply + result.plies;
+  int const score = (mate_ply < c_max_ply) ? c_mate_score - mate_ply : c_mate_bound - 1;
+  return (result.wdl == Wdl::win) ? score : -score;
+}
+} // namespace
+
+/**
+ * The state of one search thread: its own copy of the position and
+ * everything that changes from node to node.
+ */
+class SearchWorker
+{
+public:
+  /**
+   * Creates a worker
+   * @param search The search the worker belongs to
+   * @param id 0 for the main thread, otherwise a helper number
+   */
+  SearchWorker(Search& search, int id) : _search(search), _id(id)
+  {
+  }
+
+  /**
+   * Searches the root with increasing depth until the limits are reached or
+   * the search is stopped.
+   * @return The result of the last completed iteration
+   */
+  SearchResult iterate(Position const& position, std::span<uint64_t const> history);
+
+  /**
+   * @return The nodes this worker has searched. Safe to read from another
+   * thread.
+   */
+  uint64_t nodes() const
+  {
+    return _nodes.load(std::memory_order_relaxed);
+  }
+
+private:
+  int negamax_(int depth, int ply, int alpha, int beta);
+
+  /**
+   * Searches only captures and promotions that don't lose material, until
+   * the position is quiet enough for the evaluation to be trusted.
+   */
+  int quiescence_(int ply, int alpha, int beta);
+
+  /**
+   * Counts a node, checking the limits every so often on the main thread.
+   * @return True if the search has been stopped
+   */
+  bool enter_node_();
+  int aspiration_(int depth, int previous_score);
+  bool is_repetition_() const;
+
+  /**
+   * @return The tablebase result for the current position, or empty without
+   * tablebases or if no table covers it
+   */
+  std::optional<TablebaseResult> probe_tablebases_() const
+  {
+    if (!_search._tablebases)
+    {
+      return {};
+    }
+    return _search._tablebases->probe(_position);
+  }
+
+  /**
+   * Rewards a quiet move that caused a beta cutoff, and penalizes the quiet
+   * moves tried before it.
+   */
+  void update_quiet_stats_(Move move, int ply, int depth, MoveList const& tried);
+
+  /**
+   * @return True if a helper should skip searching this depth
+   */
+  bool skip_depth_(int depth) const;
+
+  bool stopped_() const
+  {
+    return _search._stop.load(std::memory_order_relaxed);
+  }
+
+  Search& _search;
+  int const _id;
+
+  Position _position{};
+
+  // Only this worker writes the count, so it doesn't need an atomic
+  // increment, just an atomic store other threads can read
+  std::atomic<uint64_t> _nodes{0};
+
+  // The hashes of every position from the start of the game to the current
+  // node, used to find repetitions
+  std::vector<uint64_t> _hashes{};
+
+  // The principal variation found from each ply
+  std::array<std::array<Move, c_max_ply>, c_max_ply> _pv{};
+  std::array<int, c_max_ply> _pv_length{};
+
+  // Move ordering statistics, kept per thread so they need no locking
+  std::array<Killers, c_max_ply> _killers{};
+  HistoryTable _history{};
+
+  // Pawn structure scores, kept per thread for the same reason
+  PawnCache _pawns{};
+
+  // Where in _hashes the last null move was made, or -1. Positions before
+  // it can't count as repetitions, and two null moves never follow each
+  // other.
+  int _null_move_index{-1};
+
+  // Null moves are turned off below this ply while a cutoff is verified
+  int _null_move_min_ply{0};
+};
+
+SearchResult SearchWorker::iterate(Position const& position, std::span<uint64_t const> history)
+{
+  _position = position;
+  _nodes.store(0, std::memory_order_relaxed);
+
+  _hashes.clear();
+  _hashes.reserve(history.size() + c_max_ply + 1);
+  _hashes.assign(history.begin(), history.end());
+  _hashes.push_back(_position.hash());
+
+  _killers.fill({c_null_move, c_null_move});
+  _history.age();
+
+  SearchResult result;
+  MoveList moves;
+  generate_legal_moves(_position, moves);
+  if (moves.empty())
+  {
+    result.score = _position.in_check() ? -c_mate_score : 0;
+    return result;
+  }
+
+  // Always have a move to play, even if the first iteration is cut short
+  result.best_move = moves[0];
+
+  bool const is_main = (_id == 0);
+  int const depth_limit = _search._limits.depth;
+  int const max_depth = (depth_limit > 0) ? std::min(depth_limit, c_max_ply - 1) : c_max_ply - 1;
+  for (int depth = 1; depth <= max_depth; depth++)
+  {
+    if (skip_depth_(depth))
+    {
+      continue;
+    }
+
+    int const score = aspiration_(depth, result.score);
+    if (stopped_())
+    {
+      break;
+    }
+
+    result.best_move = _pv[0][0];
+    result.score = score;
+    result.depth = depth;
+    result.pv.assign(_pv[0].begin(), _pv[0].begin() + _pv_length[0]);
+
+    if (is_main)
+    {
+      result.nodes = _search.nodes_();
+      result.time = _search.elapsed_();
+      if (_search._iteration_callback)
+      {
+        _search._iteration_callback(result);
+      }
+
+      // There is nothing more to learn once a forced mate has been found
+      if (std::abs(score) >= c_mate_bound && depth >= c_mate_score - std::abs(score))
+      {
+        break;
+      }
+
+      auto const soft_movetime = _search._limits.soft_movetime;
+      if (soft_movetime.count() > 0 && result.time >= soft_movetime)
+      {
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+bool SearchWorker::skip_depth_(int depth) const
+{
+  // Helpers skip blocks of depths in different patterns so that, between
+  // them, they are usually searching deeper than the main thread
+  constexpr std::array<int, 20> c_skip_size{1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+  constexpr std::array<int, 20> c_skip_phase{0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+
+  if (_id == 0)
+  {
+    return false;
+  }
+  int const index = (_id - 1) % static_cast<int>(c_skip_size.size());
+  return ((depth + c_skip_phase[index]) / c_skip_size[index]) % 2 != 0;
+}
+
+int SearchWorker::aspiration_(int depth, int previous_score)
+{
+  if (depth < c_aspiration_min_depth)
+  {
+    return negamax_(depth, 0, -c_infinity, c_infinity);
+  }
+
+  // Search a narrow window around the previous score, which fails quickly
+  // when the score has moved. Widen the side that failed and try again.
+  int window = c_aspiration_window;
+  int alpha = std::max(previous_score - window, -c_infinity);
+  int beta = std::min(previous_score + window, c_infinity);
+  while (true)
+  {
+    int const score = negamax_(depth, 0, alpha, beta);
+    if (stopped_())
+    {
+      return score;
+    }
+
+    if (score <= alpha)
+    {
+      beta = (alpha + beta) / 2;
+      alpha = std::max(score - window, -c_infinity);
+    }
+    else if (score >= beta)
+    {
+      beta = std::min(score + window, c_infinity);
+    }
+    else
+    {
+      return score;
+    }
+    window *= 2;
+  }
+}
+
+int SearchWorker::negamax_(int depth, int ply, int alpha, int beta)
+{
+  _pv_length[ply] = ply;
+  bool const in_check = _position.in_check();
+
+  // Look one move further when in check, so the search never stops with a
+  // mate threat unresolved
+  if (in_check)
+  {
+    depth++;
+  }
+
+  if (depth <= 0)
+  {
+    return quiescence_(ply, alpha, beta);
+  }
+  if (enter_node_())
+  {
+    return 0;
+  }
+  if (ply >= c_max_ply - 1)
+  {
+    return evaluate(_position, _pawns);
+  }
+
+  bool const is_root = (ply == 0);
+  bool const is_pv = (beta - alpha > 1);
+
+  if (!is_root && (_position.halfmove_clock() >= 100 || is_repetition_()))
+  {
+    return 0;
+  }
+
+  // Endgames in the tables are known exactly, so they aren't searched or
+  // evaluated, unless the game rules have already drawn them. The root is
+  // searched to find a move that keeps the result.
+  if (!is_root)
+  {
+    if (auto const result = probe_tablebases_())
+    {
+      return score_from_tablebase(*result, ply);
+    }
+  }
+
+  TranspositionTable& table = _search._table;
+  Move tt_move = c_null_move;
+  if (auto const entry = table.probe(_position.hash()))
+  {
+    tt_move = entry->move;
+    int const score = score_from_table(entry->score, ply);
+    if (!is_pv && entry->depth >= depth &&
+        (entry->bound == Bound::exact || (entry->bound == Bound::lower && score >= beta) ||
+         (entry->bound == Bound::upper && score <= alpha)))
+    {
+      return score;
+    }
+  }
+
+  Color const us = _position.side_to_move();
+  SearchFeatures const& features = _search._features;
+  int const static_eval = in_check ? -c_infinity : evaluate(_position, _pawns);
+  bool const futility_possible = features.futility_pruning && !is_pv && !in_check && depth <= c_futility_max_depth;
+
+  if (!is_pv && !in_check)
+  {
+    // So far above beta that no reply is likely to bring the score back
+    if (futility_possible && static_eval - c_futility_margin * depth >= beta && std::abs(beta) < c_mate_bound)
+    {
+      return static_eval;
+    }
+
+    // So far below alpha that only winning material could help, which is
+    // what the quiescence search looks for
+    if (features.razoring && depth <= c_razoring_max_depth && static_eval + c_razoring_margin * depth <= alpha)
+    {
+      int const score = quiescence_(ply, alpha, alpha + 1);
+      if (score <= alpha)
+      {
+        return score;
+      }
+    }
+
+    // Pawn endings are where zugzwang is common, so only try a null move
+    // with pieces on the board
+    Bitboard const pieces = _position.pieces(us) & ~_position.pieces(PieceType::pawn) & ~_position.pieces(PieceType::king);
+    bool const after_null_move = (_null_move_index == static_cast<int>(_hashes.size()) - 1);
+    if (features.null_move && depth >= c_null_move_min_depth && ply >= _null_move_min_ply && !after_null_move &&
+        pieces && static_eval >= beta && std::abs(beta) < c_mate_bound)
+    {
+      int const reduction = c_null_move_reduction + depth / 4;
+      int const previous_index = _null_move_index;
+      Undo null_undo;
+      _position.make_null_move(null_undo);
+      _hashes.push_back(_position.hash());
+      _null_move_index = static_cast<int>(_hashes.size()) - 1;
+      int score = -negamax_(depth - 1 - reduction, ply + 1, -beta, -beta + 1);
+      _null_move_index = previous_index;
+      _hashes.pop_back();
+      _position.unmake_null_move(null_undo);
+
+      if (stopped_())
+      {
+        return 0;
+      }
+      if (score >= beta)
+      {
+        // A mate found after passing isn't proven
+        score = std::min(score, c_mate_bound - 1);
+        if (depth < c_null_move_verify_depth)
+        {
+          return score;
+        }
+        _null_move_min_ply = ply + 3 * (depth - reduction) / 4;
+        int const verified = negamax_(depth - reduction, ply, beta - 1, beta);
+        _null_move_min_ply = 0;
+        if (verified >= beta)
+        {
+          return score;
+        }
+      }
+    }
+  }
+
+  int const original_alpha = alpha;
+  int best_score = -c_infinity;
+  Move best_move = c_null_move;
+  Undo undo;
+
+  // The move that was best last time comes first, then the rest in order of
+  // how likely they are to cause a cutoff
+  MovePicker picker(_position, tt_move, _killers[ply], _history);
+  MoveList quiets_tried;
+  int moves_searched = 0;
+
+  for (Move move = picker.next(); move != c_null_move; move = picker.next())
+  {
+    bool const quiet = is_quiet(_position, move);
+    _position.make_move(move, undo);
+    bool const gives_check = _position.in_check();
+
+    // Near the leaves a quiet move can't lift a hopeless position to alpha,
+    // unless it gives check
+    if (futility_possible && quiet && !gives_check && moves_searched > 0 && best_score > -c_mate_bound &&
+        static_eval + c_futility_margin * depth <= alpha)
+    {
+      _position.unmake_move(move, undo);
+      continue;
+    }
+
+    table.prefetch(_position.hash());
+    _hashes.push_back(_position.hash());
+
+    // The first move gets a full window. The others only need to be shown
+    // to be worse, unless that null window search says otherwise. Late quiet
+    // moves are tried at reduced depth first, and only searched fully if
+    // they turn out better than expected.
+    int score;
+    if (moves_searched++ == 0)
+    {
+      score = -negamax_(depth - 1, ply + 1, -beta, -alpha);
+    }
+    else
+    {
+      int reduction = 0;
+      if (features.late_move_reductions && depth >= c_reduction_min_depth && moves_searched > c_reduction_min_moves &&
+          quiet && !in_check && !gives_check)
+      {
+        reduction = c_reductions[std::min(depth, c_reduction_table_size - 1)]
+                                [std::min(moves_searched, c_reduction_table_size - 1)];
+        reduction -= _history.score(us, move) / c_reduction_history_step;
+        reduction -= is_pv ? 1 : 0;
+        reduction = std::clamp(reduction, 0, depth - 2);
+      }
+
+      score = -negamax_(depth - 1 - reduction, ply + 1, -alpha - 1, -alpha);
+      if (reduction > 0 && score > alpha)
+      {
+        score = -negamax_(depth - 1, ply + 1, -alpha - 1, -alpha);
+      }
+      if (score > alpha && score < beta)
+      {
+        score = -negamax_(depth - 1, ply + 1, -beta, -alpha);
+      }
+    }
+
+    _hashes.pop_back();
+    _position.unmake_move(move, undo);
+
+    if (stopped_())
+    {
+      return 0;
+    }
+
+    if (score > best_score)
+    {
+      best_score = score;
+      best_move = move;
+
+      if (score > alpha)
+      {
+        alpha = score;
+
+        _pv[ply][ply] = move;
+        for (int next = ply + 1; next < _pv_length[ply + 1]; next++)
+        {
+          _pv[ply][next] = _pv[ply + 1][next];
+        }
+        _pv_length[ply] = _pv_length[ply + 1];
+
+        if (alpha >= beta)
+        {
+          if (quiet)
+          {
+            update_quiet_stats_(move, ply, depth, quiets_tried);
+          }
+          break;
+        }
+      }
+    }
+
+    if (quiet)
+    {
+      quiets_tried.push_back(move);
+    }
+  }
+
+  if (moves_searched == 0)
+  {
+    return in_check ? -c_mate_score + ply : 0;
+  }
+
+  Bound const bound = (best_score >= beta)            ? Bound::lower
+                      : (best_score > original_alpha) ? Bound::exact
+                                                      : Bound::upper;
+  table.store(_position.hash(), TTEntry{best_move, static_cast<int16_t>(score_to_table(best_score, ply)),
+                                        static_cast<int8_t>(depth), bound});
+  return best_score;
+}
+
+int SearchWorker::quiescence_(int ply, int alpha, int beta)
+{
+  _pv_length[ply] = ply;
+  if (enter_node_())
+  {
+    return 0;
+  }
+  if (ply >= c_max_ply - 1)
+  {
+    return evaluate(_position, _pawns);
+  }
+
+  // A capture can lead into a table, which knows better than the evaluation
+  if (ply > 0)
+  {
+    if (auto const result = probe_tablebases_())
+    {
+      return score_from_tablebase(*result, ply);
+    }
+  }
+
+  // The side to move can usually do at least as well as the evaluation by
+  // not capturing at all (standing pat), unless it is in check
+  bool const in_check = _position.in_check();
+  int best_score = -c_infinity;
+  if (!in_check)
+  {
+    best_score = evaluate(_position, _pawns);
+    if (best_score >= beta)
+    {
+      return best_score;
+    }
+    alpha = std::max(alpha, best_score);
+  }
+
+  // Every way out of check is tried, since there is no standing pat
+  MovePicker picker = in_check ? MovePicker(_position, c_null_move, _killers[ply], _history)
+                               : MovePicker(_position, _history);
+  Undo undo;
+  bool any_move = false;
+  for (Move move = picker.next(); move != c_null_move; move = picker.next())
+  {
+    any_move = true;
+    _position.make_move(move, undo);
+    int const score = -quiescence_(ply + 1, -beta, -alpha);
+    _position.unmake_move(move, undo);
+
+    if (stopped_())
+    {
+      return 0;
+    }
+
+    if (score > best_score)
+    {
+      best_score = score;
+      if (score > alpha)
+      {
+        alpha = score;
+        if (alpha >= beta)
+        {
+          break;
+        }
+      }
+    }
+  }
+
+  if (in_check && !any_move)
+  {
+    return -c_mate_score + ply;
+  }
+  return best_score;
+}
+
+bool SearchWorker::enter_node_()
+{
+  uint64_t const nodes = _nodes.load(std::memory_order_relaxed) + 1;
+  _nodes.store(nodes, std::memory_order_relaxed);
+  if (_id == 0 && nodes % c_limit_check_interval == 0)
+  {
+    _search.check_limits_();
+  }
+  return stopped_();
+}
+
+void SearchWorker::update_quiet_stats_(Move move, int ply, int depth, MoveList const& tried)
+{
+  Killers& killers = _killers[ply];
+  if (killers[0] != move)
+  {
+    killers[1] = killers[0];
+    killers[0] = move;
+  }
+
+  // Deeper cutoffs save more work, so they count for more
+  Color const us = _position.side_to_move();
+  int const bonus = depth * depth;
+  _history.update(us, move, bonus);
+  for (Move const other : tried)
+  {
+    _history.update(us, other, -bonus);
+  }
+}
+
+bool SearchWorker::is_repetition_() const
+{
+  // Only positions with the same side to move can repeat, and nothing before
+  // the last capture or pawn move can come back
+  int const current = static_cast<int>(_hashes.size()) - 1;
+  int const oldest = std::max({0, current - _position.halfmove_clock(), _null_move_index});
+  for (int i = current - 2; i >= oldest; i -= 2)
+  {
+    if (_hashes[i] == _hashes[current])
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+Search::Search(TranspositionTable& table, int threads) : _table(table)
+{
+  set_threads(threads);
+}
+
+Search::~Search() = default;
+
+void Search::stop()
+{
+  _stop.store(true, std::memory_order_relaxed);
+}
+
+void Search::set_threads(int threads)
+{
+  _workers.clear();
+  for (int id = 0; id < std::max(threads, 1); id++)
+  {
+    _workers.push_back(std::make_unique<SearchWorker>(*this, id));
+  }
+}
+
+int Search::threads() const
+{
+  return static_cast<int>(_workers.size());
+}
+
+void Search::set_iteration_callback(std::function<void(SearchResult const&)> callback)
+{
+  _iteration_callback = std::move(callback);
+}
+
+void Search::set_tablebases(Tablebases const* tablebases)
+{
+  _tablebases = tablebases;
+}
+
+void Search::set_features(SearchFeatures const& features)
+{
+  _features = features;
+}
+
+SearchResult Search::run(Position const& position, SearchLimits const& limits, std::span<uint64_t const> history)
+{
+  _limits = limits;
+  _start = std::chrono::steady_clock::now();
+  _stop.store(false, std::memory_order_relaxed);
+  _table.new_search();
+
+  std::vector<std::thread> helpers;
+  helpers.reserve(_workers.size() - 1);
+  for (size_t id = 1; id < _workers.size(); id++)
+  {
+    helpers.emplace_back([this, id, &position, history]() { _workers[id]->iterate(position, history); });
+  }
+
+  SearchResult result = _workers[0]->iterate(position, history);
+
+  // Helpers don't check the limits, so they run until told to stop
+  stop();
+  for (auto& helper : helpers)
+  {
+    helper.join();
+  }
+
+  result.nodes = nodes_();
+  result.time = elapsed_();
+  return result;
+}
+
+uint64_t Search::nodes_() const
+{
+  uint64_t total = 0;
+  for (auto const& worker : _workers)
+  {
+    total += worker->nodes();
+  }
+  return total;
+}
+
+void Search::check_limits_()
+{
+  if ((_limits.nodes > 0 && nodes_() >= _limits.nodes) ||
+      (_limits.movetime.count() > 0 && elapsed_() >= _limits.movetime))
+  {
+    stop();
+  }
+}
+
+std::chrono::milliseconds Search::elapsed_() const
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _start);
+}
+
+std::string format_score(int score)
+{
+  if (std::abs(score) >= c_mate_bound)
+  {
+    // Convert half moves to mate into full moves, negative when being mated
+    int const plies = c_mate_score - std::abs(score);
+    int const moves = (plies + 1) / 2;
+    return "mate " + std::to_string((score > 0) ? moves : -moves);
+  }
+  return "cp " + std::to_string(score);
+}
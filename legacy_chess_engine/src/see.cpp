@@ -0,0 +1,92 @@
+#include "see.h"
+#include "attacks.h"
+#include "evaluate.h"
+#include "position.h"
+
+namespace
+{
+// A capture sequence can't be longer than the number of pieces
+constexpr int c_max_exchanges{32};
+
+int value_of(PieceType type)
+{
+  return c_piece_values[index_of(type)];
+}
+} // namespace
+
+int static_exchange(Position const& position, Move move)
+{
+  int const from = move.from();
+  int const to = move.to();
+  Bitboard occupied = position.occupied() ^ square_bb(from);
+
+  // gains[n] is what the side making capture n wins if the sequence stops
+  // there, counting from its own point of view
+  std::array<int, c_max_exchanges> gains{};
+  PieceType on_square = position.type_on(from);
+  if (move.type() == MoveType::en_passant)
+  {
+    gains[0] = value_of(PieceType::pawn);
+    occupied ^= square_bb(square_index(file_of(to), rank_of(from)));
+  }
+  else if (position.is_occupied(to))
+  {
+    gains[0] = value_of(position.type_on(to));
+  }
+  if (move.type() == MoveType::promotion)
+  {
+    gains[0] += value_of(move.promotion()) - value_of(PieceType::pawn);
+    on_square = move.promotion();
+  }
+
+  Bitboard const bishops_queens = position.pieces(PieceType::bishop) | position.pieces(PieceType::queen);
+  Bitboard const rooks_queens = position.pieces(PieceType::rook) | position.pieces(PieceType::queen);
+  Bitboard attackers = position.attackers_to(to, occupied) & occupied;
+  Color side = opposite(position.side_to_move());
+
+  int count = 1;
+  for (; count < c_max_exchanges; count++)
+  {
+    Bitboard const ours = attackers & position.pieces(side);
+    if (!ours)
+    {
+      break;
+    }
+
+    // Recapture with the least valuable piece
+    PieceType type = PieceType::pawn;
+    Bitboard candidates = 0;
+    for (int t = 0; t < c_num_piece_types; t++)
+    {
+      type = static_cast<PieceType>(t);
+      candidates = ours & position.pieces(type);
+      if (candidates)
+      {
+        break;
+      }
+    }
+
+    // The king can't capture into check, and nothing follows its capture
+    if (type == PieceType::king && (attackers & position.pieces(opposite(side))))
+    {
+      break;
+    }
+
+    gains[count] = value_of(on_square) - gains[count - 1];
+    on_square = type;
+    occupied ^= square_bb(lsb(candidates));
+
+    // Sliders behind the piece that just captured can now reach the square
+    attackers |= (Attacks::bishop(to, occupied) & bishops_queens) | (Attacks::rook(to, occupied) & rooks_queens);
+    attackers &= occupied;
+    side = opposite(side);
+  }
+
+  // Work back from the end: each side only makes a capture that gains more
+  // than stopping before it
+  while (--count > 0)
+  {
+    gains[count - 1] = -std::max(-gains[count - 1], gains[count]);
+  }
+  return gains[0];
+}
@@ -1,13 +1,7 @@
 #include "square.h"
-#include "board.h"
-#include "king.h"
-#include "piece.h"
+#include "bitboard.h"
 
-Square::Square(int x, int y) : _x(x), _y(y), _occupier(nullptr)
-{
-}
-
-Square::Square(int x, int y, Piece* occupier) : _x(x), _y(y), _occupier(occupier)
+Square::Square(int x, int y) : _x(x), _y(y)
 {
 }
 
@@ -23,36 +17,9 @@ int Square::get_y() const
   return _y;
 }
 
-bool Square::occupied() const
-{
-  return (_occupier != nullptr);
-}
-
-Piece& Square::occupied_by() const
-{
-  return *_occupier;
-}
-
-void Square::set_occupier(Piece& piece)
-{
-  _occupier = &piece;
-}
-
-void Square::remove_occupier()
-{
-  _occupier = nullptr;
-}
-
-void Square::display(std::ostream& out) const
+int Square::index() const
 {
-  if (occupied())
-  {
-    _occupier->display(out);
-  }
-  else
-  {
-    out << "___ ";
-  }
+  return square_index(_x, _y);
 }
 
 // Print the Square's location to the console.
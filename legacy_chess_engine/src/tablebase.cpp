@@ -0,0 +1,396 @@
+#include "tablebase.h"
+
+namespace
+{
+constexpr std::string_view c_magic{"LCTB"};
+constexpr uint8_t c_version{1};
+constexpr size_t c_header_size{24};
+constexpr size_t c_name_size{8};
+
+// Pieces in the order tables list them, strongest first
+constexpr std::array<PieceType, 5> c_table_order{PieceType::queen, PieceType::rook, PieceType::bishop,
+                                                 PieceType::knight, PieceType::pawn};
+
+constexpr std::string_view c_piece_letters{"PNBRQK"};
+
+/**
+ * The eight reflections and rotations of the board: bit 2 swaps files and
+ * ranks, bit 0 mirrors the files and bit 1 mirrors the ranks.
+ */
+constexpr auto c_transforms = []
+{
+  std::array<std::array<uint8_t, c_num_squares>, 8> transforms{};
+  for (int t = 0; t < 8; t++)
+  {
+    for (int square = 0; square < c_num_squares; square++)
+    {
+      int x = file_of(square);
+      int y = rank_of(square);
+      if (t & 4)
+      {
+        std::swap(x, y);
+      }
+      x = (t & 1) ? 7 - x : x;
+      y = (t & 2) ? 7 - y : y;
+      transforms[t][square] = static_cast<uint8_t>(square_index(x, y));
+    }
+  }
+  return transforms;
+}();
+
+/**
+ * Numbers the squares white's king may stand on, or -1 for the rest.
+ * @param with_pawns True for the a-d files, false for the a1-d1-d4 triangle
+ */
+constexpr std::array<int8_t, c_num_squares> king_slots(bool with_pawns)
+{
+  std::array<int8_t, c_num_squares> slots{};
+  int8_t next = 0;
+  for (int square = 0; square < c_num_squares; square++)
+  {
+    int const x = file_of(square);
+    int const y = rank_of(square);
+    bool const allowed = with_pawns ? x <= 3 : (x <= 3 && y <= x);
+    slots[square] = allowed ? next++ : -1;
+  }
+  return slots;
+}
+
+constexpr auto c_pawnless_king_slots = king_slots(false);
+constexpr auto c_pawn_king_slots = king_slots(true);
+constexpr int c_pawnless_king_squares{10};
+constexpr int c_pawn_king_squares{32};
+
+/**
+ * @return The square of each king slot
+ */
+constexpr std::array<uint8_t, c_pawn_king_squares> king_squares(std::array<int8_t, c_num_squares> const& slots)
+{
+  std::array<uint8_t, c_pawn_king_squares> squares{};
+  for (int square = 0; square < c_num_squares; square++)
+  {
+    if (slots[square] >= 0)
+    {
+      squares[slots[square]] = static_cast<uint8_t>(square);
+    }
+  }
+  return squares;
+}
+
+constexpr auto c_pawnless_king_squares_list = king_squares(c_pawnless_king_slots);
+constexpr auto c_pawn_king_squares_list = king_squares(c_pawn_king_slots);
+} // namespace
+
+std::optional<Material> Material::parse(std::string_view name)
+{
+  size_t const second_king = name.find('K', 1);
+  if (name.empty() || name.front() != 'K' || second_king == std::string_view::npos)
+  {
+    return {};
+  }
+
+  Material material;
+  for (size_t i = 0; i < name.size(); i++)
+  {
+    Color const color = (i < second_king) ? Color::white : Color::black;
+    size_t const letter = c_piece_letters.find(name[i]);
+    if (letter == std::string_view::npos || (name[i] == 'K' && i != 0 && i != second_king))
+    {
+      return {};
+    }
+    material._counts[index_of(color)][letter]++;
+  }
+  if (material.total() > c_max_tablebase_pieces)
+  {
+    return {};
+  }
+  return material;
+}
+
+Material Material::of(Position const& position)
+{
+  Material material;
+  for (int color = 0; color < c_num_colors; color++)
+  {
+    for (int type = 0; type < c_num_piece_types; type++)
+    {
+      material._counts[color][type] =
+        static_cast<uint8_t>(pop_count(position.pieces(static_cast<PieceType>(type), static_cast<Color>(color))));
+    }
+  }
+  return material;
+}
+
+std::string Material::name() const
+{
+  std::string name;
+  for (Color const color : {Color::white, Color::black})
+  {
+    name.append(count(color, PieceType::king), 'K');
+    for (PieceType const type : c_table_order)
+    {
+      name.append(count(color, type), c_piece_letters[index_of(type)]);
+    }
+  }
+  return name;
+}
+
+int Material::total() const
+{
+  int total = 0;
+  for (auto const& counts : _counts)
+  {
+    total = std::accumulate(counts.begin(), counts.end(), total);
+  }
+  return total;
+}
+
+bool Material::is_trivial_draw() const
+{
+  int const minors = count(Color::white, PieceType::bishop) + count(Color::white, PieceType::knight) +
+                     count(Color::black, PieceType::bishop) + count(Color::black, PieceType::knight);
+  return total() == 2 || (total() == 3 && minors == 1);
+}
+
+Material Material::flipped() const
+{
+  Material material;
+  material._counts = {_counts[1], _counts[0]};
+  return material;
+}
+
+Material Material::normalized() const
+{
+  for (PieceType const type : c_table_order)
+  {
+    if (count(Color::white, type) != count(Color::black, type))
+    {
+      return (count(Color::white, type) > count(Color::black, type)) ? *this : flipped();
+    }
+  }
+  return *this;
+}
+
+TablebaseIndex::TablebaseIndex(Material const& material) : _has_pawns(material.has_pawns())
+{
+  for (Color const color : {Color::white, Color::black})
+  {
+    _pieces[_count++] = {color, PieceType::king};
+    for (PieceType const type : c_table_order)
+    {
+      for (int i = 0; i < material.count(color, type); i++)
+      {
+        _pieces[_count++] = {color, type};
+      }
+    }
+  }
+
+  _size = 2 * static_cast<uint64_t>(_has_pawns ? c_pawn_king_squares : c_pawnless_king_squares);
+  for (int i = 1; i < _count; i++)
+  {
+    _size *= c_num_squares;
+  }
+}
+
+uint64_t TablebaseIndex::index(Position const& position, bool flip_colors) const
+{
+  std::array<int, c_max_tablebase_pieces> squares{};
+  for (int i = 0; i < _count; i++)
+  {
+    // Pieces of the same kind take their squares in turn from one bitboard
+    if (i > 0 && _pieces[i] == _pieces[i - 1])
+    {
+      continue;
+    }
+    auto const [color, type] = _pieces[i];
+    Bitboard pieces = position.pieces(type, flip_colors ? opposite(color) : color);
+    for (int j = i; pieces; j++)
+    {
+      int const square = pop_lsb(pieces);
+      squares[j] = flip_colors ? (square ^ 56) : square;
+    }
+  }
+  Color const side = position.side_to_move();
+  return canonical_index_(squares, flip_colors ? opposite(side) : side);
+}
+
+std::optional<Position> TablebaseIndex::position(uint64_t index) const
+{
+  int const king_squares = _has_pawns ? c_pawn_king_squares : c_pawnless_king_squares;
+  std::array<int, c_max_tablebase_pieces> squares{};
+  uint64_t rest = index;
+  for (int i = _count - 1; i > 0; i--)
+  {
+    squares[i] = static_cast<int>(rest % c_num_squares);
+    rest /= c_num_squares;
+  }
+  int const slot = static_cast<int>(rest % king_squares);
+  squares[0] = _has_pawns ? c_pawn_king_squares_list[slot] : c_pawnless_king_squares_list[slot];
+  Color const side = (rest / king_squares != 0) ? Color::white : Color::black;
+
+  Bitboard occupied = 0;
+  for (int i = 0; i < _count; i++)
+  {
+    Bitboard const square = square_bb(squares[i]);
+    bool const back_rank = (square & (c_rank_1_bb | c_rank_8_bb)) != 0;
+    if ((occupied & square) || (back_rank && _pieces[i].second == PieceType::pawn))
+    {
+      return {};
+    }
+    occupied |= square;
+  }
+  if (canonical_index_(squares, side) != index)
+  {
+    return {};
+  }
+
+  Position position;
+  for (int i = 0; i < _count; i++)
+  {
+    position.put_piece(_pieces[i].second, _pieces[i].first, squares[i]);
+  }
+  position.set_side_to_move(side);
+  if (position.is_attacked(position.king_square(opposite(side)), side))
+  {
+    return {};
+  }
+  position.update_checkers();
+  return position;
+}
+
+uint64_t TablebaseIndex::canonical_index_(std::array<int, c_max_tablebase_pieces> squares, Color side) const
+{
+  auto const& slots = _has_pawns ? c_pawn_king_slots : c_pawnless_king_slots;
+  uint64_t const king_squares = _has_pawns ? c_pawn_king_squares : c_pawnless_king_squares;
+
+  // Pawns move up the board, so only the left-right mirror keeps them legal
+  int const transforms = _has_pawns ? 2 : 8;
+  uint64_t best = UINT64_MAX;
+  for (int t = 0; t < transforms; t++)
+  {
+    int const slot = slots[c_transforms[t][squares[0]]];
+    if (slot < 0)
+    {
+      continue;
+    }
+
+    std::array<int, c_max_tablebase_pieces> mapped{};
+    for (int i = 1; i < _count; i++)
+    {
+      mapped[i] = c_transforms[t][squares[i]];
+      for (int j = i; j > 1 && _pieces[j - 1] == _pieces[j] && mapped[j - 1] > mapped[j]; j--)
+      {
+        std::swap(mapped[j - 1], mapped[j]);
+      }
+    }
+
+    uint64_t index = static_cast<uint64_t>(index_of(side)) * king_squares + static_cast<uint64_t>(slot);
+    for (int i = 1; i < _count; i++)
+    {
+      index = index * c_num_squares + static_cast<uint64_t>(mapped[i]);
+    }
+    best = std::min(best, index);
+  }
+  return best;
+}
+
+int Tablebases::add_directory(std::filesystem::path const& directory)
+{
+  std::error_code error;
+  int added = 0;
+  for (auto const& entry : std::filesystem::directory_iterator(directory, error))
+  {
+    if (entry.path().extension() == ".tb" && add(entry.path()))
+    {
+      added++;
+    }
+  }
+  return added;
+}
+
+bool Tablebases::add(std::filesystem::path const& path)
+{
+  auto file = MappedFile::open(path);
+  if (!file || file->size() < c_header_size)
+  {
+    return false;
+  }
+
+  std::string_view const header = file->text().substr(0, c_header_size);
+  std::string_view name = header.substr(8, c_name_size);
+  name = name.substr(0, name.find('\0'));
+  auto const material = Material::parse(name);
+  if (header.substr(0, c_magic.size()) != c_magic || static_cast<uint8_t>(header[4]) != c_version || !material ||
+      material->normalized() != *material)
+  {
+    return false;
+  }
+
+  uint64_t entries = 0;
+  for (size_t i = 0; i < 8; i++)
+  {
+    entries |= static_cast<uint64_t>(static_cast<uint8_t>(header[16 + i])) << (8 * i);
+  }
+  TablebaseIndex const index(*material);
+  if (entries != index.size() || file->size() != c_header_size + entries)
+  {
+    return false;
+  }
+
+  std::erase_if(_tables, [&](Table const& table) { return table.material == *material; });
+  _tables.push_back({*material, index, std::move(*file)});
+  _max_pieces = std::max(_max_pieces, material->total());
+  return true;
+}
+
+void Tablebases::clear()
+{
+  _tables.clear();
+  _max_pieces = 0;
+}
+
+bool Tablebases::write(std::filesystem::path const& path, Material const& material, std::span<uint8_t const> values)
+{
+  std::array<char, c_header_size> header{};
+  std::copy(c_magic.begin(), c_magic.end(), header.begin());
+  header[4] = static_cast<char>(c_version);
+  header[5] = static_cast<char>(material.total());
+  std::string const name = material.name();
+  std::copy(name.begin(), name.end(), header.begin() + 8);
+  for (size_t i = 0; i < 8; i++)
+  {
+    header[16 + i] = static_cast<char>((values.size() >> (8 * i)) & 0xFF);
+  }
+
+  std::ofstream out(path, std::ios::binary);
+  out.write(header.data(), header.size());
+  out.write(reinterpret_cast<char const*>(values.data()), static_cast<std::streamsize>(values.size()));
+  return static_cast<bool>(out);
+}
+
+std::optional<TablebaseResult> Tablebases::probe_(Position const& position) const
+{
+  if (position.castling_rights() != 0 || position.en_passant_square() != c_no_square)
+  {
+    return {};
+  }
+
+  Material const material = Material::of(position);
+  for (auto const& table : _tables)
+  {
+    bool const flip_colors = (table.material != material);
+    if (flip_colors && table.material != material.flipped())
+    {
+      continue;
+    }
+    uint64_t const index = table.index.index(position, flip_colors);
+    return decode_tablebase_value(static_cast<uint8_t>(table.file.bytes()[c_header_size + index]));
+  }
+
+  // Nobody can mate, so there's no table to look in
+  if (material.is_trivial_draw())
+  {
+    return TablebaseResult{};
+  }
+  return {};
+}
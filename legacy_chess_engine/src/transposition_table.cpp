@@ -0,0 +1,145 @@
+#include "transposition_table.h"
+
+namespace
+{
+constexpr int c_generation_bits{6};
+constexpr uint8_t c_generation_mask{(1 << c_generation_bits) - 1};
+
+/**
+ * Packs an entry into one 64 bit word: the move in the low 16 bits, then
+ * the score, depth, bound and generation. The top 16 bits are free.
+ */
+uint64_t pack(TTEntry const& entry, uint8_t generation)
+{
+  return static_cast<uint64_t>(entry.move.raw()) | (static_cast<uint64_t>(static_cast<uint16_t>(entry.score)) << 16) |
+         (static_cast<uint64_t>(static_cast<uint8_t>(entry.depth)) << 32) |
+         (static_cast<uint64_t>(entry.bound) << 40) | (static_cast<uint64_t>(generation) << 42);
+}
+
+TTEntry unpack(uint64_t data)
+{
+  return TTEntry{Move::from_raw(static_cast<uint16_t>(data)), static_cast<int16_t>(data >> 16),
+                 static_cast<int8_t>(data >> 32), static_cast<Bound>((data >> 40) & 3)};
+}
+
+uint8_t generation_of(uint64_t data)
+{
+  return static_cast<uint8_t>((data >> 42) & c_generation_mask);
+}
+
+Bound bound_of(uint64_t data)
+{
+  return static_cast<Bound>((data >> 40) & 3);
+}
+} // namespace
+
+TranspositionTable::TranspositionTable(size_t megabytes)
+{
+  resize(megabytes);
+}
+
+void TranspositionTable::resize(size_t megabytes)
+{
+  size_t const bytes = std::max<size_t>(megabytes, 1) * 1024 * 1024;
+  size_t const buckets = std::bit_floor(bytes / sizeof(Bucket));
+
+  _buckets.reset();
+  _buckets = std::make_unique<Bucket[]>(buckets);
+  _mask = buckets - 1;
+  _generation = 0;
+}
+
+void TranspositionTable::clear()
+{
+  for (uint64_t i = 0; i <= _mask; i++)
+  {
+    for (auto& slot : _buckets[i].slots)
+    {
+      slot.check.store(0, std::memory_order_relaxed);
+      slot.data.store(0, std::memory_order_relaxed);
+    }
+  }
+  _generation = 0;
+}
+
+void TranspositionTable::new_search()
+{
+  _generation = (_generation + 1) & c_generation_mask;
+}
+
+std::optional<TTEntry> TranspositionTable::probe(uint64_t key) const
+{
+  for (auto const& slot : bucket_(key).slots)
+  {
+    uint64_t const data = slot.data.load(std::memory_order_relaxed);
+    uint64_t const check = slot.check.load(std::memory_order_relaxed);
+    if ((data ^ check) == key && bound_of(data) != Bound::none)
+    {
+      return unpack(data);
+    }
+  }
+  return {};
+}
+
+void TranspositionTable::store(uint64_t key, TTEntry const& entry)
+{
+  Bucket& bucket = bucket_(key);
+  Slot* replace = nullptr;
+  int worst = std::numeric_limits<int>::max();
+  TTEntry stored = entry;
+
+  for (auto& slot : bucket.slots)
+  {
+    uint64_t const data = slot.data.load(std::memory_order_relaxed);
+    uint64_t const check = slot.check.load(std::memory_order_relaxed);
+
+    // Always overwrite the same position, but keep its best move if the new
+    // result doesn't have one
+    if ((data ^ check) == key)
+    {
+      if (stored.move == c_null_move)
+      {
+        stored.move = unpack(data).move;
+      }
+      replace = &slot;
+      break;
+    }
+
+    // Otherwise replace the shallowest entry, counting entries from older
+    // searches as much shallower than they really are
+    int const age = (_generation - generation_of(data)) & c_generation_mask;
+    int const value = (bound_of(data) == Bound::none) ? std::numeric_limits<int>::min() : unpack(data).depth - 8 * age;
+    if (value < worst)
+    {
+      worst = value;
+      replace = &slot;
+    }
+  }
+
+  uint64_t const data = pack(stored, _generation);
+  replace->data.store(data, std::memory_order_relaxed);
+  replace->check.store(data ^ key, std::memory_order_relaxed);
+}
+
+int TranspositionTable::hashfull() const
+{
+  int used = 0;
+  uint64_t const buckets = std::min<uint64_t>(250, _mask + 1);
+  for (uint64_t i = 0; i < buckets; i++)
+  {
+    for (auto const& slot : _buckets[i].slots)
+    {
+      uint64_t const data = slot.data.load(std::memory_order_relaxed);
+      if (bound_of(data) != Bound::none && generation_of(data) == _generation)
+      {
+        used++;
+      }
+    }
+  }
+  return static_cast<int>(used * 1000 / (buckets * 4));
+}
+
+size_t TranspositionTable::megabytes() const
+{
+  return (_mask + 1) * sizeof(Bucket) / (1024 * 1024);
+}
@@ -0,0 +1,384 @@
+#include "uci.h"
+#include "movegen.h"
+
+namespace
+{
+// Kept back from every move so the GUI's own delay doesn't lose on time
+constexpr std::chrono::milliseconds c_move_overhead{30};
+
+// How many more moves the clock is assumed to cover when the GUI doesn't say
+constexpr int c_default_moves_to_go{40};
+
+constexpr int c_max_hash_megabytes{65536};
+constexpr int c_max_threads{256};
+
+/**
+ * Sets time limits for a move from the state of the clock.
+ * @param limits The limits to fill in
+ * @param time The time left on the engine's clock
+ * @param increment The time added to the clock after each move
+ * @param moves_to_go The moves left until the next time control, or 0 if
+ * the rest of the game must be played in the remaining time
+ */
+void allot_time(SearchLimits& limits, std::chrono::milliseconds time, std::chrono::milliseconds increment,
+                int moves_to_go)
+{
+  using std::chrono::milliseconds;
+
+  milliseconds const available = std::max(time - c_move_overhead, milliseconds(1));
+  int const moves = (moves_to_go > 0) ? std::min(moves_to_go, c_default_moves_to_go) : c_default_moves_to_go;
+
+  // Aim for an even share of the clock plus most of the increment, but allow
+  // a search that is about to finish an iteration to run over
+  milliseconds const maximum = available * 4 / 5;
+  milliseconds const target = std::min(available / moves + increment * 3 / 4, maximum);
+
+  // Each iteration takes a few times longer than the one before, so one
+  // started after half the target would usually run past it
+  limits.movetime = std::min(target * 4, maximum);
+  limits.soft_movetime = std::max(target / 2, milliseconds(1));
+}
+} // namespace
+
+Uci::Uci(std::istream& in, std::ostream& out) : _in(in), _out(out)
+{
+  _search.set_tablebases(&_tablebases);
+  _search.set_iteration_callback(
+      [this](SearchResult const& result)
+      {
+        send_info_(result);
+
+        // Search::run clears the stop flag when it starts, so a stop that
+        // arrived before then has to be passed on again
+        std::lock_guard lock(_stop_mutex);
+        if (_stop_requested)
+        {
+          _search.stop();
+        }
+      });
+}
+
+Uci::~Uci()
+{
+  finish_search_(true);
+}
+
+void Uci::run()
+{
+  std::string line;
+  while (std::getline(_in, line))
+  {
+    std::istringstream command(line);
+    std::string name;
+    command >> name;
+
+    if (name == "uci")
+    {
+      send_("id name chess_engine");
+      send_("id author the chess_engine authors");
+      send_("option name Hash type spin default " + std::to_string(_table.megabytes()) + " min 1 max " +
+            std::to_string(c_max_hash_megabytes));
+      send_("option name Threads type spin default " + std::to_string(_search.threads()) + " min 1 max " +
+            std::to_string(c_max_threads));
+      send_("option name Book type string default <empty>");
+      send_("option name TablebasePath type string default <empty>");
+      send_("option name NullMove type check default true");
+      send_("option name LateMoveReductions type check default true");
+      send_("option name FutilityPruning type check default true");
+      send_("option name Razoring type check default true");
+      send_("uciok");
+    }
+    else if (name == "isready")
+    {
+      send_("readyok");
+    }
+    else if (name == "ucinewgame")
+    {
+      finish_search_(true);
+      _table.clear();
+    }
+    else if (name == "setoption")
+    {
+      handle_setoption_(command);
+    }
+    else if (name == "position")
+    {
+      handle_position_(command);
+    }
+    else if (name == "go")
+    {
+      handle_go_(command);
+    }
+    else if (name == "stop")
+    {
+      finish_search_(true);
+    }
+    else if (name == "quit")
+    {
+      finish_search_(true);
+      return;
+    }
+    else if (!name.empty() && name != "debug" && name != "ponderhit")
+    {
+      send_("info string Unknown command: " + name);
+    }
+  }
+
+  finish_search_(false);
+}
+
+void Uci::handle_setoption_(std::istringstream& command)
+{
+  // setoption name <name> value <value>, where the name may contain spaces
+  std::string token;
+  std::string name;
+  std::string value;
+  command >> token;
+  while (command >> token && token != "value")
+  {
+    name += name.empty() ? token : " " + token;
+  }
+  std::getline(command >> std::ws, value);
+
+  // Neither the table nor the threads can change under a running search
+  finish_search_(true);
+
+  if (name == "Hash")
+  {
+    _table.resize(std::clamp(std::atoi(value.c_str()), 1, c_max_hash_megabytes));
+  }
+  else if (name == "Threads")
+  {
+    _search.set_threads(std::clamp(std::atoi(value.c_str()), 1, c_max_threads));
+  }
+  else if (name == "Book")
+  {
+    _book.reset();
+    if (!value.empty() && value != "<empty>")
+    {
+      _book = OpeningBook::open(value);
+      if (!_book)
+      {
+        send_("info string Cannot open book " + value);
+      }
+    }
+  }
+  else if (name == "TablebasePath")
+  {
+    _tablebases.clear();
+    if (!value.empty() && value != "<empty>")
+    {
+      int const added = _tablebases.add_directory(value);
+      send_("info string Loaded " + std::to_string(added) + " tablebases from " + value);
+    }
+  }
+  else if (name == "NullMove" || name == "LateMoveReductions" || name == "FutilityPruning" || name == "Razoring")
+  {
+    SearchFeatures features = _search.features();
+    bool const enabled = (value == "true");
+    if (name == "NullMove")
+    {
+      features.null_move = enabled;
+    }
+    else if (name == "LateMoveReductions")
+    {
+      features.late_move_reductions = enabled;
+    }
+    else if (name == "FutilityPruning")
+    {
+      features.futility_pruning = enabled;
+    }
+    else
+    {
+      features.razoring = enabled;
+    }
+    _search.set_features(features);
+  }
+  else
+  {
+    send_("info string Unknown option: " + name);
+  }
+}
+
+void Uci::handle_position_(std::istringstream& command)
+{
+  // position startpos|fen <fen> [moves <move>...]
+  std::string token;
+  command >> token;
+
+  std::optional<Position> position;
+  if (token == "startpos")
+  {
+    position = Position::start_position();
+    command >> token;
+  }
+  else if (token == "fen")
+  {
+    std::string fen;
+    while (command >> token && token != "moves")
+    {
+      fen += token + " ";
+    }
+    position = Position::from_fen(fen);
+  }
+
+  if (!position)
+  {
+    send_("info string Invalid position");
+    return;
+  }
+
+  _history.clear();
+  if (token == "moves")
+  {
+    Undo undo;
+    while (command >> token)
+    {
+      Move const move = parse_move(*position, token);
+      if (move == c_null_move)
+      {
+        send_("info string Illegal move: " + token);
+        break;
+      }
+      _history.push_back(position->hash());
+      position->make_move(move, undo);
+    }
+  }
+  _position = *position;
+}
+
+void Uci::handle_go_(std::istringstream& command)
+{
+  using std::chrono::milliseconds;
+
+  finish_search_(true);
+
+  SearchLimits limits;
+  bool const white = (_position.side_to_move() == Color::white);
+  milliseconds time{0};
+  milliseconds increment{0};
+  int moves_to_go = 0;
+  bool infinite = false;
+
+  std::string token;
+  while (command >> token)
+  {
+    long long value = 0;
+    if (token == "infinite")
+    {
+      infinite = true;
+    }
+    else if (token == "wtime" || token == "btime")
+    {
+      command >> value;
+      if ((token == "wtime") == white)
+      {
+        time = milliseconds(value);
+      }
+    }
+    else if (token == "winc" || token == "binc")
+    {
+      command >> value;
+      if ((token == "winc") == white)
+      {
+        increment = milliseconds(value);
+      }
+    }
+    else if (token == "movestogo")
+    {
+      command >> moves_to_go;
+    }
+    else if (token == "movetime")
+    {
+      command >> value;
+      limits.movetime = milliseconds(value);
+    }
+    else if (token == "depth")
+    {
+      command >> limits.depth;
+    }
+    else if (token == "nodes")
+    {
+      command >> limits.nodes;
+    }
+  }
+
+  // An explicit move time overrides the clock
+  if (time.count() > 0 && limits.movetime.count() == 0)
+  {
+    allot_time(limits, time, increment, moves_to_go);
+  }
+
+  if (limits.depth == 0 && limits.nodes == 0 && limits.movetime.count() == 0)
+  {
+    infinite = true;
+  }
+
+  if (_book && !infinite)
+  {
+    if (Move const move = _book->pick(_position, _random()); move != c_null_move)
+    {
+      send_("info string book move");
+      send_("bestmove " + to_string(move));
+      return;
+    }
+  }
+
+  _infinite = infinite;
+  _stop_requested = false;
+  _searcher = std::thread(
+      [this, limits, infinite, position = _position, history = _history]()
+      {
+        SearchResult const result = _search.run(position, limits, history);
+        if (infinite)
+        {
+          std::unique_lock lock(_stop_mutex);
+          _stop_signal.wait(lock, [this]() { return _stop_requested; });
+        }
+        send_("bestmove " + to_string(result.best_move));
+      });
+}
+
+void Uci::send_info_(SearchResult const& result)
+{
+  auto const millis = result.time.count();
+  std::ostringstream line;
+  line << "info depth " << result.depth << " score " << format_score(result.score) << " nodes " << result.nodes
+       << " nps " << ((millis > 0) ? result.nodes * 1000 / millis : 0) << " hashfull " << _table.hashfull()
+       << " time " << millis << " pv";
+  for (auto move : result.pv)
+  {
+    line << " " << to_string(move);
+  }
+  send_(line.str());
+}
+
+void Uci::send_(std::string const& line)
+{
+  std::lock_guard lock(_output_mutex);
+  _out << line << std::endl;
+}
+
+void Uci::request_stop_()
+{
+  {
+    std::lock_guard lock(_stop_mutex);
+    _stop_requested = true;
+  }
+  _stop_signal.notify_all();
+  _search.stop();
+}
+
+void Uci::finish_search_(bool interrupt)
+{
+  if (!_searcher.joinable())
+  {
+    return;
+  }
+
+  if (interrupt || _infinite)
+  {
+    request_stop_();
+  }
+  _searcher.join();
+}
@@ -0,0 +1,286 @@
+/*
+ * File:   book_builder.cpp
+ *
+ * Builds an opening book from the opening trainer's JSON move trees and
+ * from PGN game collections.
+ *
+ * Usage:
+ *   book_builder --output <book> [--plies <n>] <file>...
+ *
+ * Files ending in .json are move trees like chess_opening_trainer's, where
+ * each key is a move in Standard Algebraic Notation and its value holds the
+ * replies to it. Every move in the tree is added with a weight of one, and
+ * a line with a move that can't be played is skipped with a warning.
+ * Other files are read as PGN, and the first n half moves of each game
+ * (default 16) are added, weighted by how often they were played.
+ */
+
+#include "book.h"
+#include "pgn.h"
+#include "san.h"
+
+namespace
+{
+constexpr int c_default_plies{16};
+
+/**
+ * Reads a JSON move tree into the book. Only objects with string keys are
+ * expected, as written by the opening trainer.
+ */
+class JsonTreeReader
+{
+public:
+  JsonTreeReader(std::string_view text, BookWriter& book) : _text(text), _book(book)
+  {
+  }
+
+  /**
+   * Adds every move in the tree.
+   * @return False if the tree isn't valid, with the reason in error()
+   */
+  bool read()
+  {
+    Position const start = Position::start_position();
+    if (!read_object_(&start))
+    {
+      return false;
+    }
+    skip_space_();
+    return _offset == _text.size() || fail_("trailing text");
+  }
+
+  /**
+   * @return Why the tree could not be read
+   */
+  std::string const& error() const
+  {
+    return _error;
+  }
+
+  /**
+   * @return The moves that could not be played, skipped along with
+   * everything below them
+   */
+  std::vector<std::string> const& skipped() const
+  {
+    return _skipped;
+  }
+
+private:
+  /**
+   * Reads one level of the tree and everything below it.
+   * @param position The position the keys are played in, or null when
+   * skipping a line that can't be played
+   */
+  bool read_object_(Position const* position)
+  {
+    if (!expect_('{'))
+    {
+      return false;
+    }
+    skip_space_();
+    if (peek_() == '}')
+    {
+      _offset++;
+      return true;
+    }
+
+    while (true)
+    {
+      std::string_view san;
+      if (!read_string_(san) || !expect_(':'))
+      {
+        return false;
+      }
+
+      // A mistake in one line shouldn't lose the rest of the tree
+      Move const move = position ? parse_san(*position, san) : c_null_move;
+      std::optional<Position> next;
+      if (move != c_null_move)
+      {
+        _book.add(position->hash(), move);
+        next = *position;
+        Undo undo;
+        next->make_move(move, undo);
+      }
+      else if (position)
+      {
+        _skipped.push_back("cannot play " + std::string(san) + " in " + position->to_fen());
+      }
+
+      if (!read_object_(next ? &*next : nullptr))
+      {
+        return false;
+      }
+
+      skip_space_();
+      char const separator = peek_();
+      _offset++;
+      if (separator == '}')
+      {
+        return true;
+      }
+      if (separator != ',')
+      {
+        return fail_("expected , or }");
+      }
+    }
+  }
+
+  bool read_string_(std::string_view& value)
+  {
+    if (!expect_('"'))
+    {
+      return false;
+    }
+    size_t const end = _text.find('"', _offset);
+    if (end == std::string_view::npos)
+    {
+      return fail_("unterminated string");
+    }
+    value = _text.substr(_offset, end - _offset);
+    _offset = end + 1;
+    return true;
+  }
+
+  bool expect_(char c)
+  {
+    skip_space_();
+    if (peek_() != c)
+    {
+      return fail_(std::string("expected ") + c);
+    }
+    _offset++;
+    return true;
+  }
+
+  void skip_space_()
+  {
+    while (_offset < _text.size() && (_text[_offset] == ' ' || _text[_offset] == '\t' || _text[_offset] == '\r' ||
+                                      _text[_offset] == '\n'))
+    {
+      _offset++;
+    }
+  }
+
+  char peek_() const
+  {
+    return (_offset < _text.size()) ? _text[_offset] : '\0';
+  }
+
+  bool fail_(std::string const& reason)
+  {
+    _error = reason + " at offset " + std::to_string(_offset);
+    return false;
+  }
+
+  std::string_view _text;
+  BookWriter& _book;
+  size_t _offset{0};
+  std::string _error{};
+  std::vector<std::string> _skipped{};
+};
+
+/**
+ * Adds the opening moves of every game in a PGN file to the book.
+ * @return The number of games read
+ */
+uint64_t add_pgn_games(std::string_view text, int plies, BookWriter& book)
+{
+  uint64_t games = 0;
+  for (size_t start = 0; start < text.size();)
+  {
+    size_t const end = next_pgn_game(text, start);
+    int ply = 0;
+    read_pgn_game(text.substr(start, end - start),
+                  [&](Position const& position, Move move)
+                  {
+                    book.add(position.hash(), move);
+                    return ++ply < plies;
+                  });
+    games += (ply > 0) ? 1 : 0;
+    start = end;
+  }
+  return games;
+}
+
+void print_usage(std::ostream& out)
+{
+  out << "Usage:" << std::endl;
+  out << "  book_builder --output <book> [--plies <n>] <file>..." << std::endl;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  std::optional<std::filesystem::path> output;
+  int plies = c_default_plies;
+  std::vector<std::filesystem::path> inputs;
+
+  for (int i = 1; i < argc; i++)
+  {
+    std::string const arg = argv[i];
+    if (arg == "--output" && i + 1 < argc)
+    {
+      output = argv[++i];
+    }
+    else if (arg == "--plies" && i + 1 < argc)
+    {
+      plies = std::max(std::atoi(argv[++i]), 1);
+    }
+    else if (!arg.starts_with("--"))
+    {
+      inputs.emplace_back(arg);
+    }
+    else
+    {
+      print_usage(std::cerr);
+      return 1;
+    }
+  }
+
+  if (!output || inputs.empty())
+  {
+    print_usage(std::cerr);
+    return 1;
+  }
+
+  BookWriter book;
+  for (auto const& input : inputs)
+  {
+    auto const file = MappedFile::open(input);
+    if (!file)
+    {
+      std::cerr << "Cannot read " << input.string() << std::endl;
+      return 1;
+    }
+
+    if (input.extension() == ".json")
+    {
+      JsonTreeReader reader(file->text(), book);
+      if (!reader.read())
+      {
+        std::cerr << input.string() << ": " << reader.error() << std::endl;
+        return 1;
+      }
+      for (auto const& skipped : reader.skipped())
+      {
+        std::cerr << input.string() << ": skipped line, " << skipped << std::endl;
+      }
+      std::cout << input.string() << ": read move tree" << std::endl;
+    }
+    else
+    {
+      file->advise_sequential();
+      std::cout << input.string() << ": read " << add_pgn_games(file->text(), plies, book) << " games" << std::endl;
+    }
+  }
+
+  if (!book.write(*output))
+  {
+    std::cerr << "Cannot write " << output->string() << std::endl;
+    return 1;
+  }
+  std::cout << "Wrote " << book.size() << " entries to " << output->string() << std::endl;
+  return 0;
+}
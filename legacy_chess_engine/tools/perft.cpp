@@ -0,0 +1,187 @@
+/*
+ * File:   perft.cpp
+ *
+ * Counts the leaf nodes of the legal move tree to check the move generator
+ * for correctness and measure its speed.
+ *
+ * Usage:
+ *   perft --depth <n> [--fen "<fen>"]   Print the node count below each root move
+ *   perft --suite [--depth <n>]        Check the reference positions, optionally
+ *                                      at a chosen depth instead of the default
+ */
+
+#include "movegen.h"
+#include "perft.h"
+#include "position.h"
+
+namespace
+{
+/**
+ * A position with its known node counts, indexed by depth - 1.
+ */
+struct ReferencePosition
+{
+  char const* name;
+  char const* fen;
+  std::vector<uint64_t> counts;
+  int suite_depth;
+};
+
+// From https://www.chessprogramming.org/Perft_Results
+std::vector<ReferencePosition> const c_reference_positions{
+    {"initial", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+     {20, 400, 8902, 197281, 4865609, 119060324},
+     5},
+    {"kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+     {48, 2039, 97862, 4085603, 193690690},
+     4},
+    {"position 3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+     {14, 191, 2812, 43238, 674624, 11030083, 178633661},
+     5},
+    {"position 4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+     {6, 264, 9467, 422333, 15833292, 706045033},
+     4},
+    {"position 5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+     {44, 1486, 62379, 2103487, 89941194},
+     4},
+    {"position 6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+     {46, 2079, 89890, 3894594, 164075551},
+     4},
+};
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @return The nodes per second for a count that took the given time
+ */
+uint64_t nodes_per_second(uint64_t nodes, Clock::duration elapsed)
+{
+  auto const micros = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+  return (micros > 0) ? nodes * 1'000'000 / micros : 0;
+}
+
+/**
+ * Prints the node count below each root move, then the total.
+ */
+int divide(Position position, int depth)
+{
+  MoveList moves;
+  generate_legal_moves(position, moves);
+
+  auto const start = Clock::now();
+  uint64_t total = 0;
+  Undo undo;
+  for (auto move : moves)
+  {
+    position.make_move(move, undo);
+    uint64_t const nodes = perft(position, depth - 1);
+    position.unmake_move(move, undo);
+
+    std::cout << to_string(move) << ": " << nodes << std::endl;
+    total += nodes;
+  }
+  auto const elapsed = Clock::now() - start;
+
+  std::cout << std::endl << "Moves: " << moves.size() << std::endl;
+  std::cout << "Nodes: " << total << std::endl;
+  std::cout << "Time: " << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << " ms"
+            << std::endl;
+  std::cout << "Nodes per second: " << nodes_per_second(total, elapsed) << std::endl;
+  return 0;
+}
+
+/**
+ * Counts every reference position and compares against the known results.
+ * @param requested_depth The depth to count to, limited by the known results,
+ * or 0 to use each position's default
+ * @return The number of positions that failed
+ */
+int run_suite(int requested_depth)
+{
+  int failures = 0;
+  uint64_t total_nodes = 0;
+  Clock::duration total_time{};
+
+  for (auto const& reference : c_reference_positions)
+  {
+    auto position = Position::from_fen(reference.fen);
+    int const known_depth = static_cast<int>(reference.counts.size());
+    int const depth = (requested_depth > 0) ? std::min(requested_depth, known_depth) : reference.suite_depth;
+
+    auto const start = Clock::now();
+    uint64_t const nodes = perft(*position, depth);
+    auto const elapsed = Clock::now() - start;
+
+    total_nodes += nodes;
+    total_time += elapsed;
+
+    bool const passed = (nodes == reference.counts[depth - 1]);
+    if (!passed)
+    {
+      failures++;
+    }
+
+    std::cout << (passed ? "PASS " : "FAIL ") << reference.name << " depth " << depth << ": " << nodes;
+    if (!passed)
+    {
+      std::cout << " (expected " << reference.counts[depth - 1] << ")";
+    }
+    std::cout << ", " << nodes_per_second(nodes, elapsed) << " nps" << std::endl;
+  }
+
+  std::cout << std::endl
+            << (c_reference_positions.size() - failures) << "/" << c_reference_positions.size()
+            << " positions passed, " << total_nodes << " nodes at " << nodes_per_second(total_nodes, total_time)
+            << " nps" << std::endl;
+  return failures;
+}
+
+void print_usage(std::ostream& out)
+{
+  out << "Usage:" << std::endl;
+  out << "  perft --depth <n> [--fen \"<fen>\"]" << std::endl;
+  out << "  perft --suite [--depth <n>]" << std::endl;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  bool suite = false;
+  int depth = 0;
+  std::string fen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+  for (int i = 1; i < argc; i++)
+  {
+    std::string const arg = argv[i];
+    if (arg == "--suite")
+    {
+      suite = true;
+    }
+    else if (arg == "--depth" && i + 1 < argc)
+    {
+      depth = std::atoi(argv[++i]);
+    }
+    else if (arg == "--fen" && i + 1 < argc)
+    {
+      fen = argv[++i];
+    }
+    else
+    {
+      print_usage(std::cerr);
+      return 1;
+    }
+  }
+
+  if (suite)
+  {
+    return (run_suite(depth) == 0) ? 0 : 1;
+  }
+
+  auto position = Position::from_fen(fen);
+  if (!position || depth < 1)
+  {
+    print_usage(std::cerr);
+    return 1;
+  }
+  return divide(*position, depth);
+}
@@ -0,0 +1,340 @@
+/*
+ * File:   pgn_replay.cpp
+ *
+ * Replays every game in PGN files against the legal move generator, to
+ * validate game databases and find the final position of each game.
+ *
+ * Usage:
+ *   pgn_replay [--threads <n>] [--quiet] <file>...
+ *
+ * Each game prints one tab separated line: its number, its result, the
+ * number of half moves played, then either the final FEN and hash or the
+ * first move that could not be played. --quiet prints only the totals,
+ * which always go to standard error.
+ *
+ * Files are memory mapped and cut into chunks of whole games, which a pool
+ * of threads replays. Only a few chunks are in flight at once and the pages
+ * of finished chunks are released, so memory use doesn't grow with the size
+ * of the file.
+ */
+
+#include "mapped_file.h"
+#include "pgn.h"
+
+namespace
+{
+// The amount of text handed to a thread at a time
+constexpr size_t c_chunk_size{1 << 20};
+
+// How many chunks each thread may have queued or waiting to be printed
+constexpr size_t c_chunks_per_thread{2};
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * The outcome of replaying one game, ready to print.
+ */
+struct GameReport
+{
+  bool valid{true};
+  int plies{0};
+  std::string line{};
+};
+
+/**
+ * Plays through one game.
+ * @param game The tags and movetext of the game
+ */
+GameReport replay_game(std::string_view game)
+{
+  PgnGame const replayed = read_pgn_game(game);
+  bool const valid = replayed.error.empty();
+
+  std::ostringstream line;
+  line << replayed.result << '\t' << replayed.plies << '\t';
+  if (valid)
+  {
+    line << replayed.position.to_fen() << '\t' << std::hex << std::setfill('0') << std::setw(16)
+         << replayed.position.hash();
+  }
+  else
+  {
+    line << "error: " << replayed.error << " in " << replayed.position.to_fen();
+  }
+  return {valid, replayed.plies, line.str()};
+}
+
+/**
+ * The replayed games of one chunk, waiting to be printed in order.
+ */
+struct ChunkReport
+{
+  std::vector<GameReport> games{};
+  uint64_t moves{0};
+  size_t end{0};
+};
+
+/**
+ * Replays the games of one file on a pool of threads.
+ */
+class Replayer
+{
+public:
+  Replayer(MappedFile const& file, int threads, bool quiet) : _file(file), _threads(threads), _quiet(quiet)
+  {
+  }
+
+  /**
+   * Replays every game in the file, printing each in file order.
+   * @param first_game The number of the first game in the file
+   */
+  void run(uint64_t first_game)
+  {
+    _next_game = first_game;
+    std::vector<std::thread> workers;
+    for (int i = 0; i < _threads; i++)
+    {
+      workers.emplace_back([this]() { work_(); });
+    }
+
+    // Cut the file into chunks of whole games, waiting whenever too many
+    // are in flight
+    std::string_view const text = _file.text();
+    size_t const limit = c_chunks_per_thread * _threads;
+    size_t start = 0;
+    for (size_t index = 0; start < text.size(); index++)
+    {
+      size_t end = text.size();
+      if (text.size() - start > c_chunk_size)
+      {
+        size_t const line = text.find('\n', start + c_chunk_size);
+        end = (line == std::string_view::npos) ? text.size() : next_pgn_game(text, line + 1);
+      }
+
+      std::unique_lock lock(_mutex);
+      _space.wait(lock, [&]() { return _queue.size() + _done.size() + _working < limit; });
+      _queue.push_back({index, start, end});
+      _work.notify_one();
+      start = end;
+    }
+
+    {
+      std::lock_guard lock(_mutex);
+      _finished = true;
+    }
+    _work.notify_all();
+    for (auto& worker : workers)
+    {
+      worker.join();
+    }
+  }
+
+  /**
+   * @return The number of games replayed
+   */
+  uint64_t games() const
+  {
+    return _games;
+  }
+
+  /**
+   * @return The number of games that had a move that could not be played
+   */
+  uint64_t errors() const
+  {
+    return _errors;
+  }
+
+  /**
+   * @return The number of moves played across every game
+   */
+  uint64_t moves() const
+  {
+    return _moves;
+  }
+
+private:
+  struct Chunk
+  {
+    size_t index;
+    size_t start;
+    size_t end;
+  };
+
+  void work_()
+  {
+    while (true)
+    {
+      Chunk chunk;
+      {
+        std::unique_lock lock(_mutex);
+        _work.wait(lock, [&]() { return !_queue.empty() || _finished; });
+        if (_queue.empty())
+        {
+          return;
+        }
+        chunk = _queue.front();
+        _queue.pop_front();
+        _working++;
+      }
+
+      std::string_view const text = _file.text().substr(0, chunk.end);
+      ChunkReport report;
+      report.end = chunk.end;
+      for (size_t start = chunk.start; start < chunk.end;)
+      {
+        size_t const end = next_pgn_game(text, start);
+        std::string_view const game = text.substr(start, end - start);
+        if (game.find_first_not_of(" \t\r\n") != std::string_view::npos)
+        {
+          report.games.push_back(replay_game(game));
+          report.moves += report.games.back().plies;
+        }
+        start = end;
+      }
+
+      std::lock_guard lock(_mutex);
+      _working--;
+      _done.emplace(chunk.index, std::move(report));
+      print_ready_();
+    }
+  }
+
+  /**
+   * Prints the finished chunks that are next in file order. Called with the
+   * mutex held.
+   */
+  void print_ready_()
+  {
+    for (auto it = _done.find(_next_chunk); it != _done.end(); it = _done.find(_next_chunk))
+    {
+      ChunkReport const& report = it->second;
+      for (auto const& game : report.games)
+      {
+        if (!_quiet)
+        {
+          std::cout << _next_game << '\t' << game.line << '\n';
+        }
+        _next_game++;
+        _games++;
+        _errors += game.valid ? 0 : 1;
+      }
+      _moves += report.moves;
+
+      // Everything before this point has been read for the last time
+      _file.release(_released, report.end - _released);
+      _released = report.end;
+
+      _done.erase(it);
+      _next_chunk++;
+      _space.notify_one();
+    }
+  }
+
+  MappedFile const& _file;
+  int const _threads;
+  bool const _quiet;
+
+  std::mutex _mutex{};
+  std::condition_variable _work{};
+  std::condition_variable _space{};
+  std::deque<Chunk> _queue{};
+  std::map<size_t, ChunkReport> _done{};
+  size_t _working{0};
+  bool _finished{false};
+
+  size_t _next_chunk{0};
+  size_t _released{0};
+  uint64_t _next_game{0};
+  uint64_t _games{0};
+  uint64_t _errors{0};
+  uint64_t _moves{0};
+};
+
+/**
+ * @return The count per second for a count that took the given time
+ */
+uint64_t per_second(uint64_t count, Clock::duration elapsed)
+{
+  auto const micros = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+  return (micros > 0) ? count * 1'000'000 / micros : 0;
+}
+
+void print_usage(std::ostream& out)
+{
+  out << "Usage:" << std::endl;
+  out << "  pgn_replay [--threads <n>] [--quiet] <file>..." << std::endl;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  int threads = static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u));
+  bool quiet = false;
+  std::vector<std::filesystem::path> paths;
+
+  for (int i = 1; i < argc; i++)
+  {
+    std::string const arg = argv[i];
+    if (arg == "--threads" && i + 1 < argc)
+    {
+      threads = std::max(std::atoi(argv[++i]), 1);
+    }
+    else if (arg == "--quiet")
+    {
+      quiet = true;
+    }
+    else if (!arg.starts_with("--"))
+    {
+      paths.emplace_back(arg);
+    }
+    else
+    {
+      print_usage(std::cerr);
+      return 1;
+    }
+  }
+
+  if (paths.empty())
+  {
+    print_usage(std::cerr);
+    return 1;
+  }
+
+  auto const start = Clock::now();
+  uint64_t games = 0;
+  uint64_t errors = 0;
+  uint64_t moves = 0;
+  uint64_t bytes = 0;
+  bool failed = false;
+
+  for (auto const& path : paths)
+  {
+    auto const file = MappedFile::open(path);
+    if (!file)
+    {
+      std::cerr << "Cannot read " << path.string() << std::endl;
+      failed = true;
+      continue;
+    }
+    file->advise_sequential();
+
+    Replayer replayer(*file, threads, quiet);
+    replayer.run(games + 1);
+    games += replayer.games();
+    errors += replayer.errors();
+    moves += replayer.moves();
+    bytes += file->size();
+  }
+  std::cout << std::flush;
+  auto const elapsed = Clock::now() - start;
+
+  std::cerr << "Games: " << games << " (" << errors << " with errors)" << std::endl;
+  std::cerr << "Moves: " << moves << std::endl;
+  std::cerr << "Time: " << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << " ms"
+            << std::endl;
+  std::cerr << "Games per second: " << per_second(games, elapsed) << std::endl;
+  std::cerr << "Moves per second: " << per_second(moves, elapsed) << std::endl;
+  std::cerr << "Megabytes per second: " << per_second(bytes, elapsed) / 1'000'000 << std::endl;
+  return (failed || errors > 0) ? 1 : 0;
+}
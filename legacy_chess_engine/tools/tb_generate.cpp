@@ -0,0 +1,565 @@
+/*
+ * File:   tb_generate.cpp
+ *
+ * Generates distance to mate endgame tables by retrograde analysis.
+ *
+ * Usage:
+ *   tb_generate --output <directory> [--threads <n>] <material>...
+ *
+ * Each material, such as KQK, KBNK or KRKP, is written to
+ * <directory>/<material>.tb, after every smaller table it can reach by a
+ * capture or a promotion. Tables already in the directory are reused.
+ *
+ * Generation starts from the checkmates and works backwards one half move at
+ * a time. The positions one move before a mate are wins; a position all of
+ * whose moves lead to wins for the opponent is a loss, one half move longer
+ * than its longest defence; and so on until no more positions change. The
+ * positions in each step are shared out between the threads. Captures and
+ * promotions leave the table, and are scored from the smaller tables.
+ */
+
+#include "attacks.h"
+#include "movegen.h"
+#include "tablebase.h"
+
+namespace
+{
+// Marks the table entries no legal position maps to, while generating
+constexpr uint8_t c_invalid{0xFF};
+
+// The number of positions a thread takes at a time
+constexpr uint64_t c_batch_size{4096};
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Runs work(item, thread) for every item below count, on several threads.
+ */
+void parallel_for(uint64_t count, int threads, std::function<void(uint64_t, int)> const& work)
+{
+  std::atomic<uint64_t> next{0};
+  std::vector<std::thread> workers;
+  for (int thread = 0; thread < threads; thread++)
+  {
+    workers.emplace_back(
+      [&, thread]()
+      {
+        for (uint64_t begin = next.fetch_add(c_batch_size); begin < count; begin = next.fetch_add(c_batch_size))
+        {
+          for (uint64_t item = begin; item < std::min(begin + c_batch_size, count); item++)
+          {
+            work(item, thread);
+          }
+        }
+      });
+  }
+  for (auto& worker : workers)
+  {
+    worker.join();
+  }
+}
+
+/**
+ * @return The squares a piece now on a square could have come from without
+ * capturing
+ */
+Bitboard unmove_sources(PieceType type, Color color, int square, Bitboard occupied)
+{
+  Bitboard const empty = ~occupied;
+  switch (type)
+  {
+  case PieceType::pawn:
+  {
+    // Pawns never stand on the first or last rank, so step back from there
+    int const back = (color == Color::white) ? -8 : 8;
+    int const rank = rank_of(square);
+    int const start_rank = (color == Color::white) ? 1 : 6;
+    int const double_rank = (color == Color::white) ? 3 : 4;
+    Bitboard sources = 0;
+    if (rank != start_rank && (empty & square_bb(square + back)))
+    {
+      sources |= square_bb(square + back);
+      if (rank == double_rank && (empty & square_bb(square + 2 * back)))
+      {
+        sources |= square_bb(square + 2 * back);
+      }
+    }
+    return sources;
+  }
+  case PieceType::knight:
+    return Attacks::knight(square) & empty;
+  case PieceType::bishop:
+    return Attacks::bishop(square, occupied) & empty;
+  case PieceType::rook:
+    return Attacks::rook(square, occupied) & empty;
+  case PieceType::queen:
+    return Attacks::queen(square, occupied) & empty;
+  case PieceType::king:
+    return Attacks::king(square) & empty;
+  }
+  return 0;
+}
+
+/**
+ * Works out one table from the smaller tables it converts into.
+ */
+class Generator
+{
+public:
+  /**
+   * @param material The pieces of the table, normalized
+   * @param tablebases The tables reached by captures and promotions
+   * @param threads The number of threads to generate with
+   */
+  Generator(Material const& material, Tablebases const& tablebases, int threads)
+    : _index(material), _tablebases(tablebases), _threads(threads), _values(new std::atomic<uint8_t>[_index.size()]()),
+      _found(static_cast<size_t>(threads)), _pending(c_max_tablebase_plies + 2)
+  {
+  }
+
+  /**
+   * Generates the table
+   * @return One byte per entry, or empty if a smaller table is missing or a
+   * mate is too long to store
+   */
+  std::optional<std::vector<uint8_t>> run()
+  {
+    parallel_for(_index.size(), _threads, [this](uint64_t index, int thread) { initialize_(index, thread); });
+
+    std::vector<uint64_t> frontier = collect_found_();
+    for (_level = 1; !_failed && _level <= c_max_tablebase_plies && (!frontier.empty() || pending_from_(_level));
+         _level++)
+    {
+      parallel_for(frontier.size(), _threads,
+                   [&](uint64_t item, int thread) { visit_predecessors_(frontier[item], thread); });
+
+      // Positions whose value was settled early, by a conversion or by
+      // a defence longer than this step
+      std::vector<uint64_t> const& pending = _pending[_level];
+      parallel_for(pending.size(), _threads,
+                   [&](uint64_t item, int thread) { settle_(pending[item], thread); });
+      frontier = collect_found_();
+    }
+    if (!_failed && (!frontier.empty() || pending_from_(_level)))
+    {
+      fail_("mate too long to store");
+    }
+    if (_failed)
+    {
+      return {};
+    }
+
+    std::vector<uint8_t> values(_index.size());
+    for (uint64_t index = 0; index < _index.size(); index++)
+    {
+      uint8_t const value = _values[index].load(std::memory_order_relaxed);
+      values[index] = (value == c_invalid) ? 0 : value;
+    }
+    return values;
+  }
+
+  /**
+   * @return Why run() failed
+   */
+  std::string const& error() const
+  {
+    return _error;
+  }
+
+private:
+  /**
+   * Marks invalid entries and checkmates, and scores the captures and
+   * promotions of each position.
+   */
+  void initialize_(uint64_t index, int thread)
+  {
+    auto const position = _index.position(index);
+    if (!position)
+    {
+      _values[index].store(c_invalid, std::memory_order_relaxed);
+      return;
+    }
+
+    MoveList moves;
+    generate_legal_moves(*position, moves);
+    if (moves.empty())
+    {
+      // Stalemates stay draws
+      if (position->in_check())
+      {
+        _values[index].store(encode_tablebase_value(0), std::memory_order_relaxed);
+        _found[thread].push_back(index);
+      }
+      return;
+    }
+
+    int fastest_win = 0;
+    int slowest_loss = 0;
+    bool can_draw = false;
+    bool stays_in_table = false;
+    for (Move const move : moves)
+    {
+      if (!position->is_occupied(move.to()) && move.type() != MoveType::promotion)
+      {
+        stays_in_table = true;
+        continue;
+      }
+
+      auto const result = conversion_(*position, move);
+      if (!result)
+      {
+        return;
+      }
+      if (result->wdl == Wdl::loss)
+      {
+        fastest_win = (fastest_win == 0) ? result->plies + 1 : std::min(fastest_win, result->plies + 1);
+      }
+      else if (result->wdl == Wdl::win)
+      {
+        slowest_loss = std::max(slowest_loss, result->plies + 1);
+      }
+      else
+      {
+        can_draw = true;
+      }
+    }
+
+    if (fastest_win > 0)
+    {
+      pend_(fastest_win, index);
+    }
+    else if (!stays_in_table && !can_draw)
+    {
+      pend_(slowest_loss, index);
+    }
+  }
+
+  /**
+   * Finds every position one move before a position settled in the last
+   * step, and settles those that are now decided.
+   */
+  void visit_predecessors_(uint64_t index, int thread)
+  {
+    Position const position = *_index.position(index);
+    Color const mover = opposite(position.side_to_move());
+    Bitboard const occupied = position.occupied();
+
+    for (Bitboard pieces = position.pieces(mover); pieces;)
+    {
+      int const to = pop_lsb(pieces);
+      for (Bitboard sources = unmove_sources(position.type_on(to), mover, to, occupied); sources;)
+      {
+        Position previous = position;
+        previous.move_piece(to, pop_lsb(sources));
+        previous.set_side_to_move(mover);
+        uint64_t const predecessor = _index.index(previous, false);
+
+        // Every move into a lost position wins. A position is only lost once
+        // every move from it has been found to lose.
+        if (_level % 2 == 1)
+        {
+          settle_(predecessor, thread);
+        }
+        else if (_values[predecessor].load(std::memory_order_relaxed) == 0)
+        {
+          int const plies = longest_defence_(predecessor);
+          if (plies == _level)
+          {
+            settle_(predecessor, thread);
+          }
+          else if (plies > _level)
+          {
+            pend_(plies, predecessor);
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * @return The half moves to mate if every move from the position loses,
+   * or 0 if some move doesn't or isn't known to lose yet
+   */
+  int longest_defence_(uint64_t index)
+  {
+    Position const position = *_index.position(index);
+    MoveList moves;
+    generate_legal_moves(position, moves);
+
+    int longest = 0;
+    for (Move const move : moves)
+    {
+      std::optional<TablebaseResult> result;
+      if (position.is_occupied(move.to()) || move.type() == MoveType::promotion)
+      {
+        result = conversion_(position, move);
+      }
+      else
+      {
+        Position child = position;
+        Undo undo;
+        child.make_move(move, undo);
+        result = decode_tablebase_value(_values[_index.index(child, false)].load(std::memory_order_relaxed));
+      }
+      if (!result || result->wdl != Wdl::win)
+      {
+        return 0;
+      }
+      longest = std::max(longest, result->plies + 1);
+    }
+    return longest;
+  }
+
+  /**
+   * @return The outcome after a move that leaves the table, or empty if its
+   * table is missing
+   */
+  std::optional<TablebaseResult> conversion_(Position const& position, Move move)
+  {
+    Position child = position;
+    Undo undo;
+    child.make_move(move, undo);
+    if (Material::of(child).is_trivial_draw())
+    {
+      return TablebaseResult{};
+    }
+
+    auto const result = _tablebases.probe(child);
+    if (!result)
+    {
+      fail_("no table for " + Material::of(child).normalized().name());
+    }
+    return result;
+  }
+
+  /**
+   * Gives a position this step's value, unless it already has one.
+   */
+  void settle_(uint64_t index, int thread)
+  {
+    uint8_t expected = 0;
+    if (_values[index].compare_exchange_strong(expected, encode_tablebase_value(_level), std::memory_order_relaxed))
+    {
+      _found[thread].push_back(index);
+    }
+  }
+
+  /**
+   * Remembers a position to settle in a later step.
+   */
+  void pend_(int plies, uint64_t index)
+  {
+    if (plies > c_max_tablebase_plies)
+    {
+      fail_("mate too long to store");
+      return;
+    }
+    std::lock_guard lock(_pending_mutex);
+    _pending[plies].push_back(index);
+  }
+
+  /**
+   * @return True if any position is waiting to be settled at this step or
+   * later
+   */
+  bool pending_from_(int level) const
+  {
+    for (int plies = level; plies < static_cast<int>(_pending.size()); plies++)
+    {
+      if (!_pending[plies].empty())
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @return The positions the threads settled in the last step
+   */
+  std::vector<uint64_t> collect_found_()
+  {
+    std::vector<uint64_t> found;
+    for (auto& positions : _found)
+    {
+      found.insert(found.end(), positions.begin(), positions.end());
+      positions.clear();
+    }
+    return found;
+  }
+
+  void fail_(std::string const& error)
+  {
+    std::lock_guard lock(_pending_mutex);
+    _failed = true;
+    _error = error;
+  }
+
+  TablebaseIndex const _index;
+  Tablebases const& _tablebases;
+  int const _threads;
+
+  // 0 until a position is known to be won or lost
+  std::unique_ptr<std::atomic<uint8_t>[]> _values;
+
+  // The half moves to mate the current step settles
+  int _level{0};
+
+  // The positions each thread settled in the current step
+  std::vector<std::vector<uint64_t>> _found;
+
+  // The positions to settle at each later step
+  std::mutex _pending_mutex{};
+  std::vector<std::vector<uint64_t>> _pending;
+
+  std::atomic<bool> _failed{false};
+  std::string _error{};
+};
+
+/**
+ * @return Every material a capture or promotion can turn the material into
+ */
+std::vector<Material> conversions(Material const& material)
+{
+  constexpr std::array<PieceType, 4> c_promotions{PieceType::queen, PieceType::rook, PieceType::bishop,
+                                                  PieceType::knight};
+  constexpr std::array<PieceType, 5> c_capturable{PieceType::queen, PieceType::rook, PieceType::bishop,
+                                                  PieceType::knight, PieceType::pawn};
+
+  std::vector<Material> results;
+  auto const add_captures = [&](Material const& before, Color victim)
+  {
+    for (PieceType const type : c_capturable)
+    {
+      if (before.count(victim, type) > 0)
+      {
+        results.push_back(before.changed(victim, type, -1));
+      }
+    }
+  };
+
+  for (Color const color : {Color::white, Color::black})
+  {
+    add_captures(material, color);
+    if (material.count(color, PieceType::pawn) == 0)
+    {
+      continue;
+    }
+    for (PieceType const type : c_promotions)
+    {
+      Material const promoted = material.changed(color, PieceType::pawn, -1).changed(color, type, 1);
+      results.push_back(promoted);
+      add_captures(promoted, opposite(color));
+    }
+  }
+  return results;
+}
+
+/**
+ * Generates a table and every table it depends on, skipping those already
+ * in the directory.
+ * @return False if a table could not be generated or written
+ */
+bool generate(Material const& material, std::filesystem::path const& directory, int threads,
+              Tablebases& tablebases)
+{
+  Material const normalized = material.normalized();
+  std::filesystem::path const path = directory / (normalized.name() + ".tb");
+  if (normalized.is_trivial_draw() || tablebases.add(path))
+  {
+    return true;
+  }
+
+  for (Material const& smaller : conversions(normalized))
+  {
+    if (!generate(smaller, directory, threads, tablebases))
+    {
+      return false;
+    }
+  }
+
+  auto const start = Clock::now();
+  Generator generator(normalized, tablebases, threads);
+  auto const values = generator.run();
+  if (!values)
+  {
+    std::cerr << normalized.name() << ": " << generator.error() << std::endl;
+    return false;
+  }
+  if (!Tablebases::write(path, normalized, *values) || !tablebases.add(path))
+  {
+    std::cerr << "Cannot write " << path.string() << std::endl;
+    return false;
+  }
+
+  // Summarize the side to move's results over the positions that exist
+  uint64_t wins = 0;
+  uint64_t losses = 0;
+  int longest = 0;
+  for (uint8_t const value : *values)
+  {
+    TablebaseResult const result = decode_tablebase_value(value);
+    wins += (result.wdl == Wdl::win) ? 1 : 0;
+    losses += (result.wdl == Wdl::loss) ? 1 : 0;
+    longest = std::max(longest, result.plies);
+  }
+  auto const elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+  std::cout << normalized.name() << ": " << wins << " wins, " << losses << " losses, longest mate " << longest
+            << " half moves, " << elapsed.count() << " ms" << std::endl;
+  return true;
+}
+
+void print_usage(std::ostream& out)
+{
+  out << "Usage:" << std::endl;
+  out << "  tb_generate --output <directory> [--threads <n>] <material>..." << std::endl;
+  out << "Materials are like KQK, KBNK or KRKP, with at most " << c_max_tablebase_pieces << " pieces" << std::endl;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  std::optional<std::filesystem::path> output;
+  int threads = static_cast<int>(std::max(std::thread::hardware_concurrency(), 1U));
+  std::vector<Material> materials;
+
+  for (int i = 1; i < argc; i++)
+  {
+    std::string const arg = argv[i];
+    if (arg == "--output" && i + 1 < argc)
+    {
+      output = argv[++i];
+    }
+    else if (arg == "--threads" && i + 1 < argc)
+    {
+      threads = std::max(std::atoi(argv[++i]), 1);
+    }
+    else if (auto const material = Material::parse(arg))
+    {
+      materials.push_back(*material);
+    }
+    else
+    {
+      print_usage(std::cerr);
+      return 1;
+    }
+  }
+
+  if (!output || materials.empty())
+  {
+    print_usage(std::cerr);
+    return 1;
+  }
+
+  std::error_code error;
+  std::filesystem::create_directories(*output, error);
+  Tablebases tablebases;
+  for (auto const& material : materials)
+  {
+    if (!generate(material, *output, threads, tablebases))
+    {
+      return 1;
+    }
+  }
+  return 0;
+}